@@ -0,0 +1,184 @@
+// Standalone benchmark of each layer between JSON bytes and R objects, built against the package's
+// own headers (see inst/include/RcppSimdJson/benchmark.hpp) and an embedded R, without which no R
+// object can be made. demo/phaseBenchmark.R runs the same phases from an R session.
+//
+// From the package's root directory, with Rcpp and simdjson.cpp available:
+//
+//   CXX="$(R CMD config CXX17) $(R CMD config CXX17STD)"
+//   RCPP="$(Rscript -e 'cat(system.file("include", package = "Rcpp"))')"
+//   $CXX -O2 -DSIMDJSON_NO_COMPUTED_GOTO $(R CMD config --cppflags) -I"$RCPP" -Iinst/include \
+//       inst/benchmark/phases.cpp -o phases $(R CMD config --ldflags)
+//   R_HOME="$(R RHOME)" ./phases inst/jsonexamples 10
+//
+// For every file in the directory and its sub-directories (NDJSON excepted) and every max_simplify_lvl, type_policy and
+// int64_policy, it prints one tab-separated row: the median seconds spent parsing, diagnosing
+// (Type_Doctor) and deserializing (diagnoses included), the throughput of the whole, and the
+// number and bytes of C++ heap allocations in each phase of a single run. R's own allocations
+// don't go through `operator new`; demo/phaseBenchmark.R measures those with the bench package.
+
+#include <RcppSimdJson.hpp>
+#include <RcppSimdJson/benchmark.hpp>
+#include <simdjson.cpp>
+
+#include <Rembedded.h>
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+
+
+namespace {
+
+std::atomic<std::size_t> n_allocations{0};
+std::atomic<std::size_t> n_allocated_bytes{0};
+
+struct Allocations {
+    std::size_t count = n_allocations;
+    std::size_t bytes = n_allocated_bytes;
+
+    [[nodiscard]] auto since(const Allocations& before) const -> Allocations {
+        return Allocations{count - before.count, bytes - before.bytes};
+    }
+};
+
+} // namespace
+
+
+void* operator new(std::size_t n) {
+    ++n_allocations;
+    n_allocated_bytes += n;
+    if (void* p = std::malloc(n == 0 ? 1 : n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+
+namespace {
+
+constexpr const char* SIMPLIFY_TO[]  = {"data_frame", "matrix", "vector", "list"};
+constexpr const char* TYPE_POLICY[]  = {"anything_goes", "numbers", "strict"};
+constexpr const char* INT64_POLICY[] = {"double", "string", "integer64", "always"};
+
+
+/* one untimed run, counting the allocations made by each phase */
+auto count_allocations(simdjson::dom::parser&                       parser,
+                       const simdjson::padded_string&               json,
+                       const rcppsimdjson::deserialize::Parse_Opts& parse_opts) {
+    using namespace rcppsimdjson;
+
+    const auto start     = Allocations();
+    const auto parsed    = parser.parse(json).value();
+    const auto parsed_at = Allocations();
+
+    deserialize::with_policies(
+        parse_opts.type_policy,
+        parse_opts.int64_r_type,
+        parse_opts.simplify_to,
+        [&parsed](auto type_policy_c, auto int64_opt_c, auto to_c) {
+            benchmark::diagnose<decltype(type_policy_c)::value,
+                                decltype(int64_opt_c)::value,
+                                decltype(to_c)::value>(parsed);
+            return R_NilValue;
+        });
+    const auto diagnosed_at = Allocations();
+
+    const auto out             = Rcpp::Shield<SEXP>(deserialize::deserialize(parsed, parse_opts));
+    const auto deserialized_at = Allocations();
+
+    return std::array<Allocations, 3>{parsed_at.since(start),
+                                      diagnosed_at.since(parsed_at),
+                                      deserialized_at.since(diagnosed_at)};
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <directory> [times]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const auto directory = std::filesystem::path(argv[1]);
+    const auto times     = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    char* r_argv[] = {const_cast<char*>("phases"),
+                      const_cast<char*>("--vanilla"),
+                      const_cast<char*>("--silent")};
+    Rf_initEmbeddedR(3, r_argv);
+    /* Rcpp's registered C callables (used by Shield, stop(), ...) */
+    Rf_eval(Rcpp::Shield<SEXP>(Rf_lang2(Rf_install("loadNamespace"), Rf_mkString("Rcpp"))),
+            R_GlobalEnv);
+
+    std::printf("file\tmax_simplify_lvl\ttype_policy\tint64_policy\tbytes"
+                "\tparse_s\tdiagnose_s\tdeserialize_s\tMB_per_s"
+                "\tparse_allocs\tdiagnose_allocs\tdeserialize_allocs"
+                "\tparse_alloc_bytes\tdiagnose_alloc_bytes\tdeserialize_alloc_bytes\n");
+
+    auto status = EXIT_SUCCESS;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") {
+            continue;
+        }
+
+        simdjson::padded_string json;
+        if (simdjson::padded_string::load(entry.path().string()).get(json) != simdjson::SUCCESS) {
+            std::fprintf(stderr, "can't read %s\n", entry.path().c_str());
+            status = EXIT_FAILURE;
+            continue;
+        }
+
+        simdjson::dom::parser parser;
+        for (int simplify_to = 0; simplify_to < 4; ++simplify_to) {
+            for (int type_policy = 0; type_policy < 3; ++type_policy) {
+                for (int int64_r_type = 0; int64_r_type < 4; ++int64_r_type) {
+                    using namespace rcppsimdjson;
+
+                    const auto parse_opts = deserialize::Parse_Opts{
+                        static_cast<deserialize::Simplify_To>(simplify_to),
+                        static_cast<deserialize::Type_Policy>(type_policy),
+                        static_cast<utils::Int64_R_Type>(int64_r_type),
+                        R_NilValue,
+                        R_NilValue,
+                        R_NilValue};
+
+                    try {
+                        const auto t = benchmark::time_phases(parser, json, parse_opts, times);
+                        const auto a = count_allocations(parser, json, parse_opts);
+
+                        std::printf("%s\t%s\t%s\t%s\t%zu\t%.6g\t%.6g\t%.6g\t%.1f"
+                                    "\t%zu\t%zu\t%zu\t%zu\t%zu\t%zu\n",
+                                    entry.path().lexically_relative(directory).c_str(),
+                                    SIMPLIFY_TO[simplify_to],
+                                    TYPE_POLICY[type_policy],
+                                    INT64_POLICY[int64_r_type],
+                                    json.size(),
+                                    t.parse,
+                                    t.diagnose,
+                                    t.deserialize,
+                                    json.size() / (t.parse + t.deserialize) / 1e6,
+                                    a[0].count,
+                                    a[1].count,
+                                    a[2].count,
+                                    a[0].bytes,
+                                    a[1].bytes,
+                                    a[2].bytes);
+                    } catch (const std::exception& e) {
+                        std::fprintf(stderr, "%s: %s\n", entry.path().c_str(), e.what());
+                        status = EXIT_FAILURE;
+                    }
+                }
+            }
+        }
+    }
+
+    Rf_endEmbeddedR(0);
+    return status;
+}
@@ -3,6 +3,11 @@
 
 
 #include "RcppSimdJson/deserialize.hpp"
+#include "RcppSimdJson/ndjson.hpp"
+#include "RcppSimdJson/ndjson_reader.hpp"
+#include "RcppSimdJson/ndjson_index.hpp"
+#include "RcppSimdJson/handle.hpp"
+#include "RcppSimdJson/result_cache.hpp"
 
 
 #endif
@@ -0,0 +1,159 @@
+#ifndef RCPPSIMDJSON__BENCHMARK_HPP
+#define RCPPSIMDJSON__BENCHMARK_HPP
+
+
+#include "deserialize.hpp"
+
+#include <algorithm> /* std::nth_element */
+#include <chrono>    /* std::chrono::steady_clock */
+#include <vector>    /* std::vector */
+
+
+namespace rcppsimdjson {
+namespace benchmark {
+
+
+/**
+ * @brief Make the compiler assume that `value` is read, so that the work producing it can't be
+ * optimized away (like Google Benchmark's `DoNotOptimize()`).
+ *
+ * Elsewhere than GCC and Clang, `value`'s first byte is read into a volatile sink instead.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "m"(value) : "memory");
+#else
+    static volatile unsigned char sink;
+    sink = *reinterpret_cast<const volatile unsigned char*>(&value);
+#endif
+}
+
+
+/**
+ * @brief Run the diagnoses that `simplify_element()` runs on `element` (the Type_Doctor s of
+ * data frames, matrices and vectors, down to `simplify_to`), without building anything.
+ *
+ * @return The number of arrays diagnosed, for `do_not_optimize()`.
+ */
+template <deserialize::Type_Policy type_policy,
+          utils::Int64_R_Type      int64_opt,
+          deserialize::Simplify_To simplify_to>
+inline auto diagnose(simdjson::dom::element element) -> std::size_t {
+    using deserialize::Simplify_To;
+    using deserialize::Type_Doctor;
+
+    auto n_diagnosed = std::size_t(0);
+
+    if (simdjson::dom::array array; element.get(array) == simdjson::SUCCESS) {
+        if (std::size(array) == 0) {
+            return n_diagnosed;
+        }
+        ++n_diagnosed;
+
+        /* each level is only diagnosed if the one above it doesn't fit, as in `simplify_*()` */
+        auto fits = false;
+        if constexpr (simplify_to <= Simplify_To::data_frame) {
+            fits = deserialize::diagnose_data_frame<type_policy, int64_opt>(array).has_value();
+        }
+        if constexpr (simplify_to <= Simplify_To::matrix) {
+            fits = fits || deserialize::matrix::diagnose<type_policy, int64_opt>(array).has_value();
+        }
+        if constexpr (simplify_to <= Simplify_To::vector) {
+            fits = fits || Type_Doctor<type_policy, int64_opt>(array).is_vectorizable();
+        }
+        do_not_optimize(fits);
+
+        for (auto child : array) {
+            n_diagnosed += diagnose<type_policy, int64_opt, simplify_to>(child);
+        }
+
+    } else if (simdjson::dom::object object; element.get(object) == simdjson::SUCCESS) {
+        for (auto [key, value] : object) {
+            n_diagnosed += diagnose<type_policy, int64_opt, simplify_to>(value);
+        }
+    }
+
+    return n_diagnosed;
+}
+
+
+/**
+ * @brief Median seconds spent in each layer between a JSON buffer and its R object.
+ */
+struct Phase_Timings {
+    double parse       = 0; /* simdjson::dom::parser::parse() */
+    double diagnose    = 0; /* the Type_Doctor diagnoses alone (see `diagnose()`) */
+    double deserialize = 0; /* `deserialize::deserialize()`, diagnoses included */
+};
+
+
+/**
+ * @brief Parse `json`, diagnose it and deserialize it `times` times, timing each phase
+ * separately.
+ *
+ * The first run is a warm-up (so that `parser` has allocated its buffers) and isn't counted.
+ */
+inline auto time_phases(simdjson::dom::parser&         parser,
+                        const simdjson::padded_string& json,
+                        const deserialize::Parse_Opts& parse_opts,
+                        const int                      times) -> Phase_Timings {
+    using clock = std::chrono::steady_clock;
+
+    if (times < 1) {
+        Rcpp::stop("`times` must be at least 1.");
+    }
+
+    const auto seconds = [](const clock::time_point from, const clock::time_point to) {
+        return std::chrono::duration<double>(to - from).count();
+    };
+    const auto median = [](std::vector<double>& x) {
+        std::nth_element(std::begin(x), std::begin(x) + std::size(x) / 2, std::end(x));
+        return x[std::size(x) / 2];
+    };
+
+    auto parse_times       = std::vector<double>();
+    auto diagnose_times    = std::vector<double>();
+    auto deserialize_times = std::vector<double>();
+
+    for (int i = 0; i <= times; ++i) {
+        const auto             start = clock::now();
+        simdjson::dom::element parsed;
+        if (auto error = parser.parse(json).get(parsed); error != simdjson::SUCCESS) {
+            Rcpp::stop(simdjson::error_message(error));
+        }
+        do_not_optimize(parsed);
+        const auto parsed_at = clock::now();
+
+        deserialize::with_policies(
+            parse_opts.type_policy,
+            parse_opts.int64_r_type,
+            parse_opts.simplify_to,
+            [&parsed](auto type_policy_c, auto int64_opt_c, auto to_c) {
+                do_not_optimize(diagnose<decltype(type_policy_c)::value,
+                                         decltype(int64_opt_c)::value,
+                                         decltype(to_c)::value>(parsed));
+                return R_NilValue;
+            });
+        const auto diagnosed_at = clock::now();
+
+        const auto out = Rcpp::Shield<SEXP>(deserialize::deserialize(parsed, parse_opts));
+        do_not_optimize(out);
+        const auto deserialized_at = clock::now();
+
+        if (i > 0) {
+            parse_times.push_back(seconds(start, parsed_at));
+            diagnose_times.push_back(seconds(parsed_at, diagnosed_at));
+            deserialize_times.push_back(seconds(diagnosed_at, deserialized_at));
+        }
+    }
+
+    return Phase_Timings{median(parse_times), median(diagnose_times), median(deserialize_times)};
+}
+
+
+} // namespace benchmark
+} // namespace rcppsimdjson
+
+
+#endif
@@ -6,6 +6,7 @@
 #include <Rcpp.h>
 
 #include <optional>
+#include <type_traits>
 
 
 namespace rcppsimdjson {
@@ -138,6 +139,24 @@ enum class Simplify_To : int {
 };
 
 
+/**
+ * @brief simdjson API used to follow queries.
+ */
+enum class Engine : int {
+    dom      = 0, /* Parse the whole document into a DOM, then follow each query. */
+    ondemand = 1, /* Follow each query with the On-Demand API, then parse only its target. */
+};
+
+
+/**
+ * @brief What documents are deserialized to.
+ */
+enum class Output : int {
+    r     = 0, /* R objects, simplified as far as `Simplify_To` allows. */
+    arrow = 1, /* Arrow C Data Interface arrays (see deserialize/arrow.hpp). */
+};
+
+
 } // namespace deserialize
 } // namespace rcppsimdjson
 
@@ -150,16 +169,110 @@ namespace rcppsimdjson {
 namespace deserialize {
 
 
+class Lazy_Strings; /* deserialize/Lazy_Strings.hpp */
+class Schema;       /* deserialize/schema.hpp */
+class Selection;    /* deserialize/select.hpp */
+class String_Cache; /* deserialize/String_Cache.hpp */
+class Tape_Cache;   /* deserialize/Tape_Cache.hpp */
+
+
+/**
+ * @brief Everything that decides how documents are deserialized, threaded through every call
+ * that builds R objects.
+ *
+ * The pointers are borrowed: whoever sets them keeps what they point to alive for as long as the
+ * options are used.
+ */
+struct Parse_Opts {
+    rcppsimdjson::deserialize::Simplify_To      simplify_to;
+    rcppsimdjson::deserialize::Type_Policy      type_policy;
+    rcppsimdjson::utils::Int64_R_Type           int64_r_type;
+    SEXP                                        empty_array;
+    SEXP                                        empty_object;
+    SEXP                                        single_null;
+    int                                         threads           = 1;
+    bool                                        use_mmap          = false;     /* mmap() files */
+    const rcppsimdjson::deserialize::Schema*    schema            = nullptr;   /* skip inference */
+    const rcppsimdjson::deserialize::Selection* selection         = nullptr;   /* only these */
+    simdjson::ondemand::parser*                 ondemand_parser   = nullptr;   /* On-Demand */
+    int                                         max_factor_levels = 0;         /* `chr` factors */
+    rcppsimdjson::deserialize::Output           output            = Output::r; /* or Arrow */
+    rcppsimdjson::deserialize::String_Cache*    string_cache      = nullptr;   /* per document */
+    rcppsimdjson::deserialize::Lazy_Strings*    lazy_strings      = nullptr;   /* lazy `chr` */
+    rcppsimdjson::deserialize::Tape_Cache*      tape_cache        = nullptr;   /* DOM files */
+};
+
+
 /**
  * @brief Simplify asimdjson::dom::element to an R object.
  *
  * @note Forward declaration. See inst/include/RcppSimdJson/deserialize/simplify.hpp.
  */
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline auto simplify_element(simdjson::dom::element element,
-                             SEXP                   empty_array,
-                             SEXP                   empty_object,
-                             SEXP                   single_null) -> SEXP;
+inline auto simplify_element(simdjson::dom::element element, const Parse_Opts& parse_opts)
+    -> SEXP;
+
+
+/**
+ * @brief Call `fun` with the run-time policies as std::integral_constant s, so that it can
+ * instantiate templates on them.
+ */
+template <typename fun_T>
+inline auto with_policies(const Type_Policy         type_policy,
+                          const utils::Int64_R_Type int64_opt,
+                          const Simplify_To         simplify_to,
+                          const fun_T&              fun) -> SEXP {
+    using Int64_R_Type = utils::Int64_R_Type;
+
+    const auto with_simplify_to = [&](auto type_policy_c, auto int64_opt_c) -> SEXP {
+        switch (simplify_to) {
+            case Simplify_To::data_frame:
+                return fun(type_policy_c,
+                           int64_opt_c,
+                           std::integral_constant<Simplify_To, Simplify_To::data_frame>());
+            case Simplify_To::matrix:
+                return fun(type_policy_c,
+                           int64_opt_c,
+                           std::integral_constant<Simplify_To, Simplify_To::matrix>());
+            case Simplify_To::vector:
+                return fun(type_policy_c,
+                           int64_opt_c,
+                           std::integral_constant<Simplify_To, Simplify_To::vector>());
+            default:
+                return fun(type_policy_c,
+                           int64_opt_c,
+                           std::integral_constant<Simplify_To, Simplify_To::list>());
+        }
+    };
+
+    const auto with_int64_opt = [&](auto type_policy_c) -> SEXP {
+        switch (int64_opt) {
+            case Int64_R_Type::Double:
+                return with_simplify_to(
+                    type_policy_c, std::integral_constant<Int64_R_Type, Int64_R_Type::Double>());
+            case Int64_R_Type::String:
+                return with_simplify_to(
+                    type_policy_c, std::integral_constant<Int64_R_Type, Int64_R_Type::String>());
+            case Int64_R_Type::Integer64:
+                return with_simplify_to(
+                    type_policy_c,
+                    std::integral_constant<Int64_R_Type, Int64_R_Type::Integer64>());
+            default:
+                return with_simplify_to(
+                    type_policy_c, std::integral_constant<Int64_R_Type, Int64_R_Type::Always>());
+        }
+    };
+
+    switch (type_policy) {
+        case Type_Policy::anything_goes:
+            return with_int64_opt(
+                std::integral_constant<Type_Policy, Type_Policy::anything_goes>());
+        case Type_Policy::ints_as_dbls:
+            return with_int64_opt(std::integral_constant<Type_Policy, Type_Policy::ints_as_dbls>());
+        default:
+            return with_int64_opt(std::integral_constant<Type_Policy, Type_Policy::strict>());
+    }
+}
 
 
 } // namespace deserialize
@@ -0,0 +1,459 @@
+#ifndef RCPPSIMDJSON__DECOMPRESS_HPP
+#define RCPPSIMDJSON__DECOMPRESS_HPP
+
+
+#include "common.hpp"
+
+#include <cstdio>      /* std::FILE */
+#include <cstdlib>     /* std::malloc, std::realloc, std::free */
+#include <cstring>     /* std::memcpy, std::memset */
+#include <memory>      /* std::unique_ptr */
+#include <string>      /* std::string */
+#include <string_view> /* std::string_view */
+
+#ifdef RCPPSIMDJSON_HAVE_ZLIB
+#    include <zlib.h>
+#endif
+#ifdef RCPPSIMDJSON_HAVE_LZMA
+#    include <lzma.h>
+#endif
+#ifdef RCPPSIMDJSON_HAVE_BZLIB
+#    include <bzlib.h>
+#endif
+
+
+namespace rcppsimdjson {
+namespace utils {
+
+
+/**
+ * @brief A growable heap buffer that always keeps simdjson::SIMDJSON_PADDING bytes of slack past
+ * its contents, so it can be handed to simdjson without being copied into a padded_string.
+ */
+class Padded_Buffer {
+    struct Free {
+        void operator()(char* ptr) const noexcept { std::free(ptr); }
+    };
+
+    std::unique_ptr<char[], Free> data_;
+    std::size_t                   size_     = 0;
+    std::size_t                   capacity_ = 0;
+
+  public:
+    Padded_Buffer() = default;
+
+    [[nodiscard]] auto data() const noexcept -> const char* { return data_.get(); }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return capacity_; }
+    [[nodiscard]] auto view() const noexcept -> std::string_view { return {data_.get(), size_}; }
+
+    /** @brief Writable space past the contents (which `commit()` then appends). */
+    [[nodiscard]] auto tail() noexcept -> char* { return data_.get() + size_; }
+    [[nodiscard]] auto tail_size() const noexcept -> std::size_t { return capacity_ - size_; }
+    void               commit(const std::size_t n) noexcept { size_ += n; }
+
+    /** @brief Ensure room for at least `n` bytes of contents; `false` if out of memory. */
+    [[nodiscard]] auto reserve(const std::size_t n) noexcept -> bool {
+        if (n <= capacity_) {
+            return true;
+        }
+        auto ptr = static_cast<char*>(std::realloc(data_.get(), n + simdjson::SIMDJSON_PADDING));
+        if (ptr == nullptr) {
+            return false; // # nocov
+        }
+        data_.release();
+        data_.reset(ptr);
+        capacity_ = n;
+        return true;
+    }
+
+    /** @brief Grow geometrically when full; `false` if out of memory. */
+    [[nodiscard]] auto grow() noexcept -> bool {
+        return size_ < capacity_ || reserve(std::max<std::size_t>(capacity_ * 2, 1 << 16));
+    }
+
+    /** @brief Zero the padding once the contents are complete. */
+    void finish() noexcept {
+        if (data_ != nullptr) {
+            std::memset(data_.get() + size_, 0, simdjson::SIMDJSON_PADDING);
+        }
+    }
+};
+
+
+/**
+ * @brief Whether `file_type` (as returned by `get_memDecompress_type()`) can be decompressed
+ * without `memDecompress()`, depending on the libraries found by `configure`.
+ */
+inline constexpr bool has_native_decompress(const std::string_view file_type) noexcept {
+#ifdef RCPPSIMDJSON_HAVE_ZLIB
+    if (file_type == "gzip") {
+        return true;
+    }
+#endif
+#ifdef RCPPSIMDJSON_HAVE_LZMA
+    if (file_type == "xz") {
+        return true;
+    }
+#endif
+#ifdef RCPPSIMDJSON_HAVE_BZLIB
+    if (file_type == "bzip2") {
+        return true;
+    }
+#endif
+    return static_cast<void>(file_type), false;
+}
+
+
+namespace native {
+
+
+inline static constexpr std::size_t READ_CHUNK_SIZE = 1 << 16;
+
+
+struct File_Closer {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+using File_Ptr = std::unique_ptr<std::FILE, File_Closer>;
+
+
+/**
+ * @brief Compressed bytes that are already in memory (e.g. a downloaded body), read like a file.
+ */
+struct Memory_Reader {
+    std::string_view bytes;
+    std::size_t      position = 0;
+};
+
+
+/** @brief Read up to `n` bytes from `source` (a file or a Memory_Reader) into `buffer`. */
+inline auto read_chunk(std::FILE* file, void* buffer, const std::size_t n) noexcept -> std::size_t {
+    return std::fread(buffer, 1, n, file);
+}
+inline auto read_chunk(Memory_Reader* reader, void* buffer, const std::size_t n) noexcept
+    -> std::size_t {
+    const auto n_read = std::min(n, std::size(reader->bytes) - reader->position);
+    std::memcpy(buffer, std::data(reader->bytes) + reader->position, n_read);
+    reader->position += n_read;
+    return n_read;
+}
+
+
+/**
+ * @brief gzip stores the (mod 2^32) size of the last member's uncompressed data in its final four
+ * bytes, which is a good first guess at the buffer size. It's capped at deflate's maximum ratio
+ * (about 1032:1) in case those bytes aren't what they should be. zlib streams (which is what
+ * `memCompress(type = "gzip")` writes) carry no size, so they get no hint. The file is left at its
+ * start.
+ */
+inline auto gzip_size_hint(std::FILE* file) noexcept -> std::size_t {
+    unsigned char magic[2];
+    if (std::fread(magic, 1, 2, file) != 2 || magic[0] != 0x1f || magic[1] != 0x8b) {
+        std::rewind(file);
+        return 0;
+    }
+
+    unsigned char isize[4];
+    if (std::fseek(file, 0, SEEK_END) != 0) {
+        return 0; // # nocov
+    }
+    const auto file_size = std::ftell(file);
+    if (file_size < 4 || std::fseek(file, -4, SEEK_END) != 0 ||
+        std::fread(isize, 1, 4, file) != 4) {
+        std::rewind(file);
+        return 0;
+    }
+    std::rewind(file);
+
+    const auto hint = static_cast<std::size_t>(isize[0]) |
+                      static_cast<std::size_t>(isize[1]) << 8 |
+                      static_cast<std::size_t>(isize[2]) << 16 |
+                      static_cast<std::size_t>(isize[3]) << 24;
+    /* one spare byte lets inflate() see the end of the stream without growing the buffer */
+    return hint == 0 ? 0 : std::min(hint, static_cast<std::size_t>(file_size) * 1032) + 1;
+}
+inline auto gzip_size_hint(Memory_Reader* reader) noexcept -> std::size_t {
+    const auto bytes = reinterpret_cast<const unsigned char*>(std::data(reader->bytes));
+    const auto size  = std::size(reader->bytes);
+    if (size < 6 || bytes[0] != 0x1f || bytes[1] != 0x8b) {
+        return 0;
+    }
+
+    const auto hint = static_cast<std::size_t>(bytes[size - 4]) |
+                      static_cast<std::size_t>(bytes[size - 3]) << 8 |
+                      static_cast<std::size_t>(bytes[size - 2]) << 16 |
+                      static_cast<std::size_t>(bytes[size - 1]) << 24;
+    return hint == 0 ? 0 : std::min(hint, size * 1032) + 1;
+}
+
+
+#ifdef RCPPSIMDJSON_HAVE_ZLIB
+template <typename source_T>
+inline auto gunzip(source_T source, Padded_Buffer& out) -> const char* {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) { /* 15 + 32: zlib or gzip header */
+        return "failed to initialize zlib"; // # nocov
+    }
+    const auto end_stream = std::unique_ptr<z_stream, int (*)(z_stream*)>(&stream, inflateEnd);
+
+    if (!out.reserve(gzip_size_hint(source))) {
+        return "not enough memory to decompress"; // # nocov
+    }
+
+    unsigned char in[READ_CHUNK_SIZE];
+    auto          status    = Z_OK;
+    auto          any_input = false;
+    while (true) {
+        if (stream.avail_in == 0) {
+            stream.avail_in = static_cast<uInt>(read_chunk(source, in, READ_CHUNK_SIZE));
+            stream.next_in  = in;
+            if (stream.avail_in == 0) {
+                break;
+            }
+            any_input = true;
+        }
+        if (!out.grow()) {
+            return "not enough memory to decompress"; // # nocov
+        }
+        const auto avail_out = static_cast<uInt>(std::min<std::size_t>(out.tail_size(), UINT_MAX));
+        stream.next_out  = reinterpret_cast<Bytef*>(out.tail());
+        stream.avail_out = avail_out;
+
+        status = inflate(&stream, Z_NO_FLUSH);
+        out.commit(avail_out - stream.avail_out);
+
+        if (status == Z_STREAM_END) {
+            /* concatenated gzip members are a valid gzip file */
+            if (inflateReset(&stream) != Z_OK) {
+                return "gzip data corrupted"; // # nocov
+            }
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            return "gzip data corrupted";
+        }
+    }
+
+    return status == Z_STREAM_END || !any_input ? nullptr : "gzip data truncated";
+}
+#endif
+
+
+#ifdef RCPPSIMDJSON_HAVE_LZMA
+template <typename source_T>
+inline auto unxz(source_T source, Padded_Buffer& out) -> const char* {
+    lzma_stream stream = LZMA_STREAM_INIT;
+    if (lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+        return "failed to initialize lzma"; // # nocov
+    }
+    const auto end_stream =
+        std::unique_ptr<lzma_stream, void (*)(lzma_stream*)>(&stream, lzma_end);
+
+    uint8_t in[READ_CHUNK_SIZE];
+    auto    action = LZMA_RUN;
+    while (true) {
+        if (stream.avail_in == 0 && action == LZMA_RUN) {
+            stream.avail_in = read_chunk(source, in, READ_CHUNK_SIZE);
+            stream.next_in  = in;
+            if (stream.avail_in == 0) {
+                action = LZMA_FINISH;
+            }
+        }
+        if (!out.grow()) {
+            return "not enough memory to decompress"; // # nocov
+        }
+        stream.next_out  = reinterpret_cast<uint8_t*>(out.tail());
+        stream.avail_out = out.tail_size();
+
+        const auto status = lzma_code(&stream, action);
+        out.commit(out.tail_size() - stream.avail_out);
+
+        if (status == LZMA_STREAM_END) {
+            return nullptr;
+        }
+        if (status != LZMA_OK) {
+            return "xz data corrupted";
+        }
+    }
+}
+#endif
+
+
+#ifdef RCPPSIMDJSON_HAVE_BZLIB
+template <typename source_T>
+inline auto bunzip2(source_T source, Padded_Buffer& out) -> const char* {
+    bz_stream stream{};
+    if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+        return "failed to initialize bzip2"; // # nocov
+    }
+    const auto end_stream =
+        std::unique_ptr<bz_stream, int (*)(bz_stream*)>(&stream, BZ2_bzDecompressEnd);
+
+    char in[READ_CHUNK_SIZE];
+    auto status    = BZ_OK;
+    auto any_input = false;
+    while (true) {
+        if (stream.avail_in == 0) {
+            stream.avail_in =
+                static_cast<unsigned int>(read_chunk(source, in, READ_CHUNK_SIZE));
+            stream.next_in  = in;
+            if (stream.avail_in == 0) {
+                break;
+            }
+            any_input = true;
+        }
+        if (!out.grow()) {
+            return "not enough memory to decompress"; // # nocov
+        }
+        const auto avail_out =
+            static_cast<unsigned int>(std::min<std::size_t>(out.tail_size(), UINT_MAX));
+        stream.next_out  = out.tail();
+        stream.avail_out = avail_out;
+
+        status = BZ2_bzDecompress(&stream);
+        out.commit(avail_out - stream.avail_out);
+
+        if (status == BZ_STREAM_END) {
+            /* concatenated bzip2 streams (e.g. from pbzip2) are a valid bzip2 file */
+            BZ2_bzDecompressEnd(&stream);
+            const auto avail_in = stream.avail_in;
+            const auto next_in  = stream.next_in;
+            stream              = bz_stream{};
+            if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+                return "failed to initialize bzip2"; // # nocov
+            }
+            stream.avail_in = avail_in;
+            stream.next_in  = next_in;
+        } else if (status != BZ_OK) {
+            return "bzip2 data corrupted";
+        }
+    }
+
+    return status == BZ_STREAM_END || !any_input ? nullptr : "bzip2 data truncated";
+}
+#endif
+
+
+template <typename source_T>
+inline auto decompress_from(source_T source, const std::string_view file_type, Padded_Buffer& out)
+    -> const char* {
+    auto error = "unsupported compression type";
+#ifdef RCPPSIMDJSON_HAVE_ZLIB
+    if (file_type == "gzip") {
+        error = gunzip(source, out);
+    }
+#endif
+#ifdef RCPPSIMDJSON_HAVE_LZMA
+    if (file_type == "xz") {
+        error = unxz(source, out);
+    }
+#endif
+#ifdef RCPPSIMDJSON_HAVE_BZLIB
+    if (file_type == "bzip2") {
+        error = bunzip2(source, out);
+    }
+#endif
+    return static_cast<void>(source), error;
+}
+
+
+} // namespace native
+
+
+/**
+ * @brief Stream-decompress `file_path` straight into `out`, without touching the R API (so it is
+ * safe to call from worker threads).
+ *
+ * Only one compressed chunk and the (growing) decompressed buffer are ever held in memory.
+ *
+ * @return `nullptr` on success, otherwise an error message.
+ */
+inline auto decompress_native(const std::string&     file_path,
+                              const std::string_view file_type,
+                              Padded_Buffer&         out) -> const char* {
+    const auto file = native::File_Ptr(std::fopen(file_path.c_str(), "rb"));
+    if (!file) {
+        return "cannot open file";
+    }
+
+    auto error = native::decompress_from(file.get(), file_type, out);
+    if (error == nullptr && std::ferror(file.get())) {
+        error = "error reading file"; // # nocov
+    }
+    out.finish();
+    return error;
+}
+
+
+/**
+ * @brief Decompress `bytes` that are already in memory (such as a downloaded body) into `out`, as
+ * `decompress_native()` does for files.
+ */
+inline auto decompress_native_bytes(const std::string_view bytes,
+                                    const std::string_view file_type,
+                                    Padded_Buffer&         out) -> const char* {
+    auto reader = native::Memory_Reader{bytes};
+    auto error  = native::decompress_from(&reader, file_type, out);
+    out.finish();
+    return error;
+}
+
+
+/**
+ * @brief The `memDecompress()` type of `bytes`, recognized by its magic number, if compressed.
+ *
+ * None of these can start a JSON text. zlib streams (as written by `memCompress(type = "gzip")`)
+ * are "gzip" too: they start with 0x78 and a header checksum.
+ */
+inline auto get_compression_type(const std::string_view bytes) noexcept
+    -> std::optional<std::string_view> {
+    if (bytes.substr(0, 2) == std::string_view("\x1f\x8b", 2)) {
+        return "gzip";
+    }
+    if (std::size(bytes) >= 2 && bytes[0] == '\x78' &&
+        (static_cast<unsigned char>(bytes[0]) * 256 + static_cast<unsigned char>(bytes[1])) % 31 ==
+            0) {
+        return "gzip";
+    }
+    if (bytes.substr(0, 6) == std::string_view("\xfd" "7zXZ\0", 6)) {
+        return "xz";
+    }
+    if (bytes.substr(0, 3) == "BZh") {
+        return "bzip2";
+    }
+    return std::nullopt;
+}
+
+
+/**
+ * @brief Decompress a `memDecompress()`-compatible file into a padded buffer that simdjson can
+ * parse in place.
+ *
+ * `file_type`s without native support fall back to `decompress()`, which must run on the main
+ * thread.
+ */
+inline auto decompress_padded(const std::string& file_path, const std::string_view file_type)
+    -> Padded_Buffer {
+    Padded_Buffer out;
+
+    if (has_native_decompress(file_type)) {
+        if (const auto error = decompress_native(file_path, file_type, out)) {
+            Rcpp::stop("Failed to decompress file (%s):\n\t-%s", error, file_path);
+        }
+        return out;
+    }
+
+    const auto decompressed = decompress(file_path, Rcpp::String(std::string(file_type)));
+    if (!out.reserve(std::size(decompressed))) {
+        Rcpp::stop("Not enough memory to decompress file:\n\t-%s", file_path); // # nocov
+    }
+    std::copy(std::begin(decompressed), std::end(decompressed), out.tail());
+    out.commit(std::size(decompressed));
+    out.finish();
+    return out;
+}
+
+
+} // namespace utils
+} // namespace rcppsimdjson
+
+
+#endif
@@ -2,7 +2,22 @@
 #define RCPPSIMDJSON__DESERIALIZE_HPP
 
 
+#include "decompress.hpp"
+#include "deserialize/Tape_Cache.hpp"
+#include "deserialize/arrow.hpp"
+#include "deserialize/schema.hpp"
+#include "deserialize/select.hpp"
 #include "deserialize/simplify.hpp"
+#include "mapped_file.hpp"
+#include "ondemand.hpp"
+#include "prefetch.hpp"
+#include "zero_copy.hpp"
+
+#include <exception> /* std::exception_ptr, std::rethrow_exception */
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif
 
 
 namespace rcppsimdjson {
@@ -28,16 +43,6 @@ inline static constexpr auto YES_DEBUG = true;
 inline static constexpr auto NO_DEBUG  = false;
 
 
-struct Parse_Opts {
-    rcppsimdjson::deserialize::Simplify_To simplify_to;
-    rcppsimdjson::deserialize::Type_Policy type_policy;
-    rcppsimdjson::utils::Int64_R_Type      int64_r_type;
-    SEXP                                   empty_array;
-    SEXP                                   empty_object;
-    SEXP                                   single_null;
-};
-
-
 /**
  * @brief Deserialize a parsed  simdjson::dom::element to R objects.
  *
@@ -59,398 +64,184 @@ struct Parse_Opts {
  * @return The simplified R object ( SEXP ).
  */
 inline auto deserialize(simdjson::dom::element parsed, const Parse_Opts& parse_opts) -> SEXP {
-    using Int64_R_Type = utils::Int64_R_Type;
-
-    auto& [simplify_to, type_policy, int64_opt, empty_array, empty_object, single_null] =
-        parse_opts;
-
-    // THE GREAT DISPATCHER
-    switch (type_policy) {
-        case Type_Policy::anything_goes: {
-            switch (int64_opt) {
-                case Int64_R_Type::Double: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Double:
-
-                case Int64_R_Type::String: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::String:
-
-                case Int64_R_Type::Integer64: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Integer64:
-
-                case Int64_R_Type::Always: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::anything_goes,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Always:
-            }         // switch(int64_opt)
-        }             // case Type_Policy::anything_goes:
-
-
-        case Type_Policy::ints_as_dbls: {
-            switch (int64_opt) {
-                case Int64_R_Type::Double: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Double:
-
-                case Int64_R_Type::String: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::String:
-
-                case Int64_R_Type::Integer64: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Integer64:
-
-                case Int64_R_Type::Always: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::ints_as_dbls,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Always:
-            }         // switch(int64_opt)
-        }             // case Type_Policy::ints_as_dbls
-
-
-        case Type_Policy::strict: {
-            switch (int64_opt) {
-                case Int64_R_Type::Double: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::strict, //
-                                                    Int64_R_Type::Double,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Double:
-
-                case Int64_R_Type::String: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::strict, //
-                                                    Int64_R_Type::String,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::String:
-
-                case Int64_R_Type::Integer64: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Integer64,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type:Integer64:
-
-                case Int64_R_Type::Always: {
-                    switch (simplify_to) {
-                        case Simplify_To::data_frame:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::data_frame>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::matrix:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::matrix>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::vector:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::vector>(
-                                parsed, empty_array, empty_object, single_null);
-
-                        case Simplify_To::list:
-                            return simplify_element<Type_Policy::strict,
-                                                    Int64_R_Type::Always,
-                                                    Simplify_To::list>(
-                                parsed, empty_array, empty_object, single_null);
-                    } // switch(simplify_to)
-                }     // case Int64_R_Type::Always:
-            }         // switch(Int64_R_Type)
-        }             // Type_Policy::strict
-    }
-
-    return R_NilValue; // # nocov
+    const auto simplify_to = parse_opts.simplify_to;
+    const auto type_policy = parse_opts.type_policy;
+    const auto int64_opt   = parse_opts.int64_r_type;
+
+    if (parse_opts.output == Output::arrow) {
+        return arrow::build_arrow(parsed);
+    }
+
+    /* intern repeated strings (keys, enum-like values) for the duration of this document, unless
+     * `parsed` is part of a document already being deserialized (such as a schema's list cell) */
+    String_Cache string_cache;
+    auto         doc_opts = parse_opts;
+    if (!doc_opts.string_cache) {
+        doc_opts.string_cache = &string_cache;
+    }
+
+    if (parse_opts.schema) {
+        const auto deserialize_cell = [&doc_opts](simdjson::dom::element cell) {
+            auto cell_opts   = doc_opts;
+            cell_opts.schema = nullptr;
+            return deserialize(cell, cell_opts);
+        };
+        return build_schema_data_frame(
+            parsed, *parse_opts.schema, doc_opts.string_cache, deserialize_cell);
+    }
+
+    if (parse_opts.selection) {
+        const auto build = [&parsed, &doc_opts](auto type_policy_c, auto int64_opt_c, auto to_c) {
+            return build_selected_data_frame<decltype(type_policy_c)::value,
+                                             decltype(int64_opt_c)::value,
+                                             decltype(to_c)::value>(
+                parsed, *doc_opts.selection, doc_opts);
+        };
+        return with_policies(type_policy, int64_opt, simplify_to, build);
+    }
+
+    const auto simplify = [&parsed, &doc_opts](auto type_policy_c, auto int64_opt_c, auto to_c) {
+        return simplify_element<decltype(type_policy_c)::value,
+                                decltype(int64_opt_c)::value,
+                                decltype(to_c)::value>(parsed, doc_opts);
+    };
+    return with_policies(type_policy, int64_opt, simplify_to, simplify);
+}
+
+
+/**
+ * @brief `parser.parse()`, but into a new document of `lazy` (if any), so that its strings
+ * outlive `parser`.
+ */
+inline simdjson::simdjson_result<simdjson::dom::element>
+parse_buffer(simdjson::dom::parser& parser,
+             const char*            json,
+             const std::size_t      len,
+             const bool             realloc,
+             Lazy_Strings* const    lazy = nullptr) {
+    if (lazy) {
+        return parser.parse_into_document(lazy->new_document(), json, len, realloc);
+    }
+    return parser.parse(json, len, realloc);
+}
+
+
+/**
+ * @brief `parser.load()`, but into a new document of `lazy` (if any).
+ */
+inline simdjson::simdjson_result<simdjson::dom::element> load_file(
+    simdjson::dom::parser& parser, const std::string& path, Lazy_Strings* const lazy = nullptr) {
+    if (lazy) {
+        return parser.load_into_document(lazy->new_document(), path);
+    }
+    return parser.load(path);
+}
+
+
+/**
+ * @brief Parse the file at `path`.
+ *
+ * Uncompressed files are read into a padded buffer by `parser.load()`, unless `use_mmap`, in which
+ * case they are memory-mapped and parsed in place so that peak memory is the tape, not the tape
+ * plus a copy of the file.
+ */
+inline simdjson::simdjson_result<simdjson::dom::element>
+parse_file(simdjson::dom::parser& parser,
+           const std::string&     path,
+           const bool             use_mmap,
+           Lazy_Strings* const    lazy = nullptr) {
+    /* check for a `memDecompress()`-compatible file extension... */
+    if (const auto file_type = utils::get_memDecompress_type(std::string_view(path))) {
+        /* ... and decompress to a padded buffer if so, then parse that without a copy */
+        const auto decompressed = utils::decompress_padded(path, *file_type);
+        return parse_buffer(parser, decompressed.data(), decompressed.size(), false, lazy);
+    }
+    if (use_mmap && utils::has_mmap()) { /* ... or map it and parse it in place... */
+        utils::Mapped_File mapped;
+        if (const auto error = mapped.map(path); error) {
+            return error;
+        }
+        return parse_buffer(parser, mapped.data(), mapped.size(), false, lazy);
+    }
+    return load_file(parser, path, lazy); /* otherwise, just load the file */
 }
 
 
+/**
+ * @brief `parse_file()`, through `cache`: from the cached tape if it's up to date, otherwise
+ * parsing the file and caching its tape.
+ */
+inline simdjson::simdjson_result<simdjson::dom::element>
+parse_cached_file(Tape_Cache&            cache,
+                  simdjson::dom::parser& parser,
+                  const std::string&     path,
+                  const bool             use_mmap,
+                  Lazy_Strings* const    lazy) {
+    /* documents deserialized into lazy strings must outlive the cache's mappings */
+    if (auto cached = cache.load(path, [lazy]() -> simdjson::dom::document* {
+            return lazy ? &lazy->new_document() : nullptr;
+        })) {
+        return std::move(*cached);
+    }
+
+    auto parsed = parse_file(parser, path, use_mmap, lazy);
+    if (parsed.error() == simdjson::SUCCESS) {
+        using Document = simdjson::dom::document;
+        cache.save(path, lazy ? *Rcpp::XPtr<Document>(lazy->document()) : parser.doc);
+    }
+    return parsed;
+}
+
+
+/**
+ * @brief Parse `json`, which is a file path if `is_file` (see `parse_file()`), into a document of
+ * `lazy` if there is one, and through `tape_cache` if there is one (see `parse_cached_file()`).
+ */
 template <typename json_T, bool is_file>
-inline simdjson::simdjson_result<simdjson::dom::element> parse(simdjson::dom::parser& parser,
-                                                               const json_T&          json) {
+inline simdjson::simdjson_result<simdjson::dom::element>
+parse(simdjson::dom::parser& parser,
+      const json_T&          json,
+      const bool             use_mmap   = false,
+      Lazy_Strings* const    lazy       = nullptr,
+      Tape_Cache* const      tape_cache = nullptr) {
     if constexpr (utils::resembles_vec_raw<json_T>()) {
-        /* if `json` is a raw (unsigned char) vector, we can cheat */
-        return parser.parse(
-            std::string_view(reinterpret_cast<const char*>(&(json[0])), std::size(json)));
+        /* if `json` is a raw (unsigned char) vector, we can cheat (and maybe skip the copy) */
+        const auto buffer = utils::json_buffer(static_cast<SEXP>(json));
+        return parse_buffer(
+            parser, buffer.json.data(), std::size(buffer.json), buffer.realloc_if_needed, lazy);
     }
 
     if constexpr (utils::resembles_vec_chr<json_T>()) {
         /* if `json` is a character vector, we're only parsing the first element */
-        return parse<decltype(json[0]), is_file>(parser, json[0]);
+        return parse<decltype(json[0]), is_file>(parser, json[0], use_mmap, lazy, tape_cache);
     }
 
     if constexpr (utils::resembles_r_string<json_T>()) {
-        if constexpr (is_file) { /* if `json` is a string and file path...*/
-            /* ... check for a `memDecompress()`-compatible file extension... */
-            if (const auto file_type = utils::get_memDecompress_type(std::string_view(json))) {
-                return parse<Rcpp::RawVector, IS_NOT_FILE>(
-                    parser, /* ... and decompress to a RawVector if so, then parse that */
-                    utils::decompress(std::string(json), Rcpp::String(std::string(*file_type))));
+        if constexpr (is_file) {
+            if (tape_cache) {
+                return parse_cached_file(*tape_cache, parser, std::string(json), use_mmap, lazy);
             }
-            return parser.load(std::string(json)); /* otherwise, just `parser::load()` the file */
-        } else {
-            return parser.parse(std::string_view(json)); /* if not file, just parse the string */
+            return parse_file(parser, std::string(json), use_mmap, lazy);
+        } else { /* if not file, just parse the string (in place if that's safe) */
+            const auto buffer = utils::json_buffer(std::string_view(json));
+            return parse_buffer(
+                parser, buffer.json.data(), std::size(buffer.json), buffer.realloc_if_needed, lazy);
         }
     }
 }
 
 
+/**
+ * @brief `parse()` as `parse_opts` ask.
+ */
+template <typename json_T, bool is_file>
+inline simdjson::simdjson_result<simdjson::dom::element>
+parse(simdjson::dom::parser& parser, const json_T& json, const Parse_Opts& parse_opts) {
+    return parse<json_T, is_file>(
+        parser, json, parse_opts.use_mmap, parse_opts.lazy_strings, parse_opts.tape_cache);
+}
+
+
 template <bool query_error_ok>
 inline SEXP query_and_deserialize(simdjson::dom::element                       parsed,
                                   const Rcpp::String::const_StringProxy&       query,
@@ -494,14 +285,15 @@ inline SEXP parse_and_deserialize(simdjson::dom::parser&                       p
 
     if constexpr (parse_error_ok) {
         simdjson::dom::element parsed;
-        if(simdjson::SUCCESS == parse<json_T, is_file>(parser, json).get(parsed)) {
+        if (simdjson::SUCCESS ==
+            parse<json_T, is_file>(parser, json, parse_opts).get(parsed)) {
             return deserialize(parsed, parse_opts);
         }
         return on_parse_error;
 
     } else {
         simdjson::dom::element parsed;
-        auto error = parse<json_T, is_file>(parser, json).get(parsed);
+        auto error = parse<json_T, is_file>(parser, json, parse_opts).get(parsed);
         if (error != simdjson::SUCCESS) {
             Rcpp::stop(simdjson::error_message(error));
         }
@@ -510,6 +302,124 @@ inline SEXP parse_and_deserialize(simdjson::dom::parser&                       p
 }
 
 
+/**
+ * @brief Follow `query` through `doc` with the On-Demand API, then parse and deserialize only its
+ * target.
+ *
+ * Errors met while following `query` that mean the document is invalid are parse errors. If
+ * `parse_error_ok`, they set `parse_failed` instead of throwing.
+ */
+template <bool parse_error_ok, bool query_error_ok>
+inline SEXP ondemand_query_and_deserialize(simdjson::dom::parser&                 parser,
+                                           Ondemand_Doc&                          doc,
+                                           const Rcpp::String::const_StringProxy& query,
+                                           SEXP                                   on_query_error,
+                                           const Parse_Opts&                      parse_opts,
+                                           bool&                                  parse_failed) {
+    if (utils::is_na_string(query)) {
+        return Rcpp::LogicalVector(1, NA_LOGICAL);
+    }
+
+    const auto on_parse_failure = [&parse_failed](const simdjson::error_code error) -> SEXP {
+        if constexpr (parse_error_ok) {
+            static_cast<void>(error);
+            parse_failed = true;
+            return R_NilValue;
+        } else {
+            Rcpp::stop(simdjson::error_message(error));
+        }
+    };
+
+    /* as with the DOM, an empty query ("") is the entire document */
+    auto target = doc.json();
+    if (!query.empty()) {
+        if (const auto error = doc.find(std::string_view(query)).get(target); error) {
+            if (!is_query_error(error)) {
+                return on_parse_failure(error);
+            }
+            if constexpr (query_error_ok) {
+                return on_query_error;
+            } else {
+                Rcpp::stop(simdjson::error_message(error));
+            }
+        }
+    }
+
+    /* `target` lies within the padded document, so it's followed by readable bytes */
+    simdjson::dom::element parsed;
+    if (const auto error =
+            parse_buffer(parser, target.data(), target.size(), false, parse_opts.lazy_strings)
+                .get(parsed);
+        error) {
+        return on_parse_failure(error);
+    }
+    return deserialize(parsed, parse_opts);
+}
+
+
+/**
+ * @brief Run every query against the same On-Demand document, returning a list named after
+ * `query`.
+ */
+template <bool parse_error_ok, bool query_error_ok>
+inline SEXP ondemand_query_all_and_deserialize(simdjson::dom::parser&       parser,
+                                               Ondemand_Doc&                doc,
+                                               const Rcpp::CharacterVector& query,
+                                               SEXP                         on_query_error,
+                                               const Parse_Opts&            parse_opts,
+                                               bool&                        parse_failed) {
+    const R_xlen_t n_queries = std::size(query);
+    Rcpp::List     out(n_queries);
+
+    for (R_xlen_t j = 0; j < n_queries && !parse_failed; ++j) {
+        out[j] = ondemand_query_and_deserialize<parse_error_ok, query_error_ok>(
+            parser, doc, query[j], on_query_error, parse_opts, parse_failed);
+    }
+
+    out.attr("names") = query.attr("names");
+    return out;
+}
+
+
+/**
+ * @brief `parse_query_and_deserialize()` and `parse_queries_and_deserialize()` with the On-Demand
+ * API, where `query_T` is a single query or a `character` vector of them.
+ */
+template <typename json_T,
+          bool is_file,
+          bool parse_error_ok,
+          bool query_error_ok,
+          typename query_T>
+inline SEXP ondemand_parse_query_and_deserialize(simdjson::dom::parser& parser,
+                                                 const json_T&          json,
+                                                 const query_T&         query,
+                                                 SEXP                   on_parse_error,
+                                                 SEXP                   on_query_error,
+                                                 const Parse_Opts&      parse_opts) {
+    Ondemand_Doc doc;
+    if (const auto error =
+            doc.load<json_T, is_file>(*parse_opts.ondemand_parser, json, parse_opts.use_mmap);
+        error) {
+        if constexpr (parse_error_ok) {
+            return on_parse_error;
+        } else {
+            Rcpp::stop(simdjson::error_message(error));
+        }
+    }
+
+    auto          parse_failed = false;
+    Rcpp::RObject out;
+    if constexpr (std::is_same_v<query_T, Rcpp::CharacterVector>) {
+        out = ondemand_query_all_and_deserialize<parse_error_ok, query_error_ok>(
+            parser, doc, query, on_query_error, parse_opts, parse_failed);
+    } else {
+        out = ondemand_query_and_deserialize<parse_error_ok, query_error_ok>(
+            parser, doc, query, on_query_error, parse_opts, parse_failed);
+    }
+    return parse_failed ? on_parse_error : static_cast<SEXP>(out);
+}
+
+
 template <typename json_T, bool is_file, bool parse_error_ok, bool query_error_ok>
 inline SEXP parse_query_and_deserialize(simdjson::dom::parser&                 parser,
                                         const json_T&                          json,
@@ -520,17 +430,25 @@ inline SEXP parse_query_and_deserialize(simdjson::dom::parser&                 p
     if (utils::is_na_string(json)) {
         return Rcpp::LogicalVector(1, NA_LOGICAL);				// #nocov
     }
+    if (parse_opts.ondemand_parser) {
+        return ondemand_parse_query_and_deserialize<json_T,
+                                                    is_file,
+                                                    parse_error_ok,
+                                                    query_error_ok>(
+            parser, json, query, on_parse_error, on_query_error, parse_opts);
+    }
 
     if constexpr (parse_error_ok) {
         simdjson::dom::element parsed;
-        if(simdjson::SUCCESS == parse<json_T, is_file>(parser, json).get(parsed)) {
+        if (simdjson::SUCCESS ==
+            parse<json_T, is_file>(parser, json, parse_opts).get(parsed)) {
             return query_and_deserialize<query_error_ok>(parsed, query, on_query_error, parse_opts);
         }
         return on_parse_error;
 
     } else {
         simdjson::dom::element parsed;
-        auto error = parse<json_T, is_file>(parser, json).get(parsed);
+        auto error = parse<json_T, is_file>(parser, json, parse_opts).get(parsed);
         if (error != simdjson::SUCCESS) {
             Rcpp::stop(simdjson::error_message(error));
         }
@@ -539,21 +457,368 @@ inline SEXP parse_query_and_deserialize(simdjson::dom::parser&                 p
 }
 
 
+/**
+ * @brief Run every query against the same parsed element, returning a list named after `query`.
+ */
+template <bool query_error_ok>
+inline SEXP query_all_and_deserialize(simdjson::dom::element       parsed,
+                                      const Rcpp::CharacterVector& query,
+                                      SEXP                         on_query_error,
+                                      const Parse_Opts&            parse_opts) {
+    const R_xlen_t n_queries = std::size(query);
+    Rcpp::List     out(n_queries);
+
+    for (R_xlen_t j = 0; j < n_queries; ++j) {
+        out[j] =
+            query_and_deserialize<query_error_ok>(parsed, query[j], on_query_error, parse_opts);
+    }
+
+    out.attr("names") = query.attr("names");
+    return out;
+}
+
+
+/**
+ * @brief Parse `json` exactly once, then run all of `query` against it.
+ */
+template <typename json_T, bool is_file, bool parse_error_ok, bool query_error_ok>
+inline SEXP parse_queries_and_deserialize(simdjson::dom::parser&       parser,
+                                          const json_T&                json,
+                                          const Rcpp::CharacterVector& query,
+                                          SEXP                         on_parse_error,
+                                          SEXP                         on_query_error,
+                                          const Parse_Opts&            parse_opts) {
+    if (utils::is_na_string(json)) {
+        return Rcpp::LogicalVector(1, NA_LOGICAL);
+    }
+    if (parse_opts.ondemand_parser) {
+        return ondemand_parse_query_and_deserialize<json_T,
+                                                    is_file,
+                                                    parse_error_ok,
+                                                    query_error_ok>(
+            parser, json, query, on_parse_error, on_query_error, parse_opts);
+    }
+
+    if constexpr (parse_error_ok) {
+        simdjson::dom::element parsed;
+        if (simdjson::SUCCESS ==
+            parse<json_T, is_file>(parser, json, parse_opts).get(parsed)) {
+            return query_all_and_deserialize<query_error_ok>(
+                parsed, query, on_query_error, parse_opts);
+        }
+        return on_parse_error;
+
+    } else {
+        simdjson::dom::element parsed;
+        auto error = parse<json_T, is_file>(parser, json, parse_opts).get(parsed);
+        if (error != simdjson::SUCCESS) {
+            Rcpp::stop(simdjson::error_message(error));
+        }
+        return query_all_and_deserialize<query_error_ok>(parsed, query, on_query_error, parse_opts);
+    }
+}
+
+
+/**
+ * @brief What a worker thread needs to parse one element of a (non-single) `json` without touching
+ * the R API.
+ */
+struct Parse_Input {
+    std::string_view json;                      /* the JSON, or a file path if `is_file_path` */
+    bool             is_na             = false; /* `NA_character_` never gets parsed */
+    bool             is_file_path      = false;
+    std::string_view compression;               /* natively decompressed by the worker if set */
+    bool             realloc_if_needed = true;  /* false if `json` can be parsed in place */
+};
+
+
+/**
+ * @brief Parse every element of `json` across `threads` threads, then deserialize on this one.
+ *
+ * The work happens in blocks. Within a block, each thread parses elements with its own
+ * simdjson::dom::parser into per-element simdjson::dom::document s (each owning its tape and
+ * strings). Once the block is parsed, every document is handed to `deserialize_parsed` on the
+ * calling thread, since building R objects must never happen elsewhere.
+ *
+ * Compressed files are decompressed by the workers when the library is available, otherwise
+ * up-front (`memDecompress()` is an R function).
+ *
+ * @param deserialize_parsed Callable taking a simdjson::dom::element and returning a SEXP .
+ */
+template <typename json_T, bool is_file, bool parse_error_ok, typename deserialize_T>
+inline SEXP parallel_parse_and_deserialize(const json_T&        json,
+                                           SEXP                 on_parse_error,
+                                           const Parse_Opts&    parse_opts,
+                                           const deserialize_T& deserialize_parsed) {
+    const R_xlen_t n       = std::size(json);
+    const int      threads = parse_opts.threads;
+
+    std::vector<Parse_Input>          inputs(n);
+    std::vector<utils::Padded_Buffer> decompressed;
+    for (R_xlen_t i = 0; i < n; ++i) {
+        if constexpr (utils::resembles_vec_raw<decltype(json[i])>()) {
+            const auto buffer           = utils::json_buffer(static_cast<SEXP>(json[i]));
+            inputs[i].json              = buffer.json;
+            inputs[i].realloc_if_needed = buffer.realloc_if_needed;
+        } else {
+            if (utils::is_na_string(json[i])) {
+                inputs[i].is_na = true;
+                continue;
+            }
+            inputs[i].json = std::string_view(json[i]);
+
+            if constexpr (!is_file) {
+                inputs[i].realloc_if_needed = utils::json_buffer(inputs[i].json).realloc_if_needed;
+            } else {
+                inputs[i].is_file_path = true;
+                if (const auto file_type = utils::get_memDecompress_type(inputs[i].json)) {
+                    if (utils::has_native_decompress(*file_type)) {
+                        inputs[i].compression = *file_type;
+                    } else {
+                        decompressed.push_back(utils::decompress_padded(
+                            std::string(inputs[i].json), *file_type));
+                        inputs[i].json              = decompressed.back().view();
+                        inputs[i].is_file_path      = false;
+                        inputs[i].realloc_if_needed = false;
+                    }
+                }
+            }
+        }
+    }
+
+    const R_xlen_t                         block_size = static_cast<R_xlen_t>(threads) * 64;
+    std::vector<simdjson::dom::parser>     parsers(threads);
+    std::vector<simdjson::dom::document>   docs(std::min(n, block_size));
+    std::vector<simdjson::error_code>      errors(std::size(docs));
+    std::vector<const char*>               decompress_errors(std::size(docs));
+    Rcpp::List                             out(n);
+
+    for (R_xlen_t block_start = 0; block_start < n; block_start += block_size) {
+        const R_xlen_t block_end = std::min(n, block_start + block_size);
+
+#ifdef _OPENMP
+#    pragma omp parallel for num_threads(threads) schedule(dynamic)
+#endif
+        for (R_xlen_t i = block_start; i < block_end; ++i) {
+#ifdef _OPENMP
+            auto& parser = parsers[omp_get_thread_num()];
+#else
+            auto& parser = parsers[0];
+#endif
+            const auto& input            = inputs[i];
+            auto&       doc              = docs[i - block_start];
+            auto&       error            = errors[i - block_start];
+            auto&       decompress_error = decompress_errors[i - block_start];
+
+            if (input.is_na) {
+                continue;
+            }
+            if (!input.compression.empty()) {
+                utils::Padded_Buffer buffer;
+                decompress_error =
+                    utils::decompress_native(std::string(input.json), input.compression, buffer);
+                if (decompress_error != nullptr) {
+                    error = simdjson::IO_ERROR;
+                } else {
+                    error = parser.parse_into_document(doc, buffer.data(), buffer.size(), false)
+                                .error();
+                }
+            } else if (input.is_file_path && parse_opts.use_mmap && utils::has_mmap()) {
+                utils::Mapped_File mapped;
+                if (error = mapped.map(std::string(input.json)); !error) {
+                    error = parser.parse_into_document(doc, mapped.data(), mapped.size(), false)
+                                .error();
+                }
+            } else if (input.is_file_path) {
+                simdjson::padded_string file_contents;
+                if (error = simdjson::padded_string::load(input.json).get(file_contents); !error) {
+                    error = parser.parse_into_document(doc, file_contents).error();
+                }
+            } else {
+                error = parser
+                            .parse_into_document(doc,
+                                                 input.json.data(),
+                                                 std::size(input.json),
+                                                 input.realloc_if_needed)
+                            .error();
+            }
+        }
+
+        for (R_xlen_t i = block_start; i < block_end; ++i) {
+            /* as with `memDecompress()`, a file that can't be decompressed is always an error */
+            if (const auto message = decompress_errors[i - block_start]) {
+                Rcpp::stop("Failed to decompress file (%s):\n\t-%s",
+                           message,
+                           std::string(inputs[i].json));
+            }
+            if (inputs[i].is_na) {
+                out[i] = Rcpp::LogicalVector(1, NA_LOGICAL);
+            } else if (const auto error = errors[i - block_start]; error != simdjson::SUCCESS) {
+                if constexpr (parse_error_ok) {
+                    out[i] = on_parse_error;
+                } else {
+                    Rcpp::stop(simdjson::error_message(error));
+                }
+            } else if (auto* const lazy = parse_opts.lazy_strings) {
+                /* strings may still point into the document once the block's are reused */
+                out[i] = deserialize_parsed(lazy->adopt(docs[i - block_start]));
+            } else {
+                out[i] = deserialize_parsed(docs[i - block_start].root());
+            }
+        }
+    }
+
+    out.attr("names") = json.attr("names");
+    return out;
+}
+
+
+/**
+ * @brief Parse and deserialize file `i` of `json`, as read by a utils::File_Prefetcher (see
+ * `prefetch_parse_and_deserialize()`).
+ */
+template <bool parse_error_ok, typename deserialize_T>
+inline SEXP deserialize_prefetched(simdjson::dom::parser&               parser,
+                                   const utils::File_Prefetcher::File& file,
+                                   const Rcpp::CharacterVector&         json,
+                                   const R_xlen_t                       i,
+                                   SEXP                                 on_parse_error,
+                                   const Parse_Opts&                    parse_opts,
+                                   const deserialize_T&                 deserialize_parsed) {
+    if (utils::is_na_string(json[i])) {
+        return Rcpp::LogicalVector(1, NA_LOGICAL);
+    }
+    /* as with `memDecompress()`, a file that can't be decompressed is always an error */
+    if (file.decompress_error) {
+        Rcpp::stop("Failed to decompress file (%s):\n\t-%s",
+                   file.decompress_error,
+                   std::string(json[i]));
+    }
+
+    simdjson::dom::element parsed;
+    auto                   error = file.error;
+    if (!file.is_read) { /* compressed, but left to `memDecompress()` */
+        error = parse<decltype(json[i]), IS_FILE>(parser, json[i], parse_opts).get(parsed);
+    } else if (!error) {
+        const auto  contents = file.json();
+        auto* const lazy     = parse_opts.lazy_strings;
+        error = parse_buffer(parser, contents.data(), std::size(contents), false, lazy).get(parsed);
+    }
+
+    if (error != simdjson::SUCCESS) {
+        if constexpr (parse_error_ok) {
+            return on_parse_error;
+        } else {
+            Rcpp::stop(simdjson::error_message(error));
+        }
+    }
+    return deserialize_parsed(parsed);
+}
+
+
+/**
+ * @brief Parse every file of `json` on this thread while the next ones are read on another (see
+ * utils::File_Prefetcher), handing each document to `deserialize_parsed`.
+ *
+ * This is the single-threaded counterpart of `parallel_parse_and_deserialize()`: disk latency and
+ * decompression overlap with parsing and deserializing, but documents are still parsed one at a
+ * time with `parser`.
+ *
+ * The files are deserialized under `Rcpp::unwindProtect()`, so that an R error's longjmp (e.g.
+ * from `Rf_mkCharLenCE()` on an embedded NUL) unwinds as an exception past the prefetcher, whose
+ * reader thread is then joined. C++ exceptions can't cross R's frames either: they're caught, and
+ * thrown again once past them.
+ *
+ * @param deserialize_parsed Callable taking a simdjson::dom::element and returning a SEXP .
+ */
+template <bool parse_error_ok, typename deserialize_T>
+inline SEXP prefetch_parse_and_deserialize(simdjson::dom::parser&       parser,
+                                           const Rcpp::CharacterVector& json,
+                                           SEXP                         on_parse_error,
+                                           const Parse_Opts&            parse_opts,
+                                           const deserialize_T&         deserialize_parsed) {
+    const R_xlen_t n = std::size(json);
+    Rcpp::List     out(n);
+
+    utils::File_Prefetcher files(json);
+    auto                   exception = std::exception_ptr();
+    const auto             read_all  = [&]() -> SEXP {
+        try {
+            for (R_xlen_t i = 0; i < n; ++i) {
+                out[i] = deserialize_prefetched<parse_error_ok>(
+                    parser, files.take(i), json, i, on_parse_error, parse_opts, deserialize_parsed);
+            }
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        return R_NilValue;
+    };
+#ifdef RCPP_USING_UNWIND_PROTECT
+    Rcpp::unwindProtect(read_all);
+#else
+    read_all();
+#endif
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    out.attr("names") = json.attr("names");
+    return out;
+}
+
+
+/**
+ * @brief Whether files are prefetched (see `prefetch_parse_and_deserialize()`): only when they are
+ * loaded on one thread, through the DOM, read rather than memory-mapped, and not cached, and only
+ * if there are enough of them (see `utils::File_Prefetcher::is_worthwhile()`).
+ */
+template <typename json_T, bool is_file>
+inline constexpr bool can_prefetch() noexcept {
+    return is_file && std::is_same_v<json_T, Rcpp::CharacterVector>;
+}
+inline bool use_prefetch(const Rcpp::CharacterVector& json, const Parse_Opts& parse_opts) {
+    return parse_opts.threads == 1 && !parse_opts.ondemand_parser &&
+           !(parse_opts.use_mmap && utils::has_mmap()) && !parse_opts.tape_cache &&
+           utils::File_Prefetcher::is_worthwhile(json);
+}
+
+
 template <typename json_T,
           bool is_file,
           bool is_single_json,
           bool parse_error_ok,
           bool query_error_ok>
-inline SEXP no_query(const json_T&                                json,
+inline SEXP no_query(simdjson::dom::parser&                       parser,
+                     const json_T&                                json,
                      SEXP                                         on_parse_error,
                      const rcppsimdjson::deserialize::Parse_Opts& parse_opts) {
-    simdjson::dom::parser parser;
-
     if constexpr (is_single_json) {
         return parse_and_deserialize<json_T, is_file, parse_error_ok>(
             parser, json, on_parse_error, parse_opts);
 
     } else { /* !single_json */
+        if (parse_opts.threads > 1) {
+            return parallel_parse_and_deserialize<json_T, is_file, parse_error_ok>(
+                json,
+                on_parse_error,
+                parse_opts,
+                [&parse_opts](simdjson::dom::element parsed) {
+                    return deserialize(parsed, parse_opts);
+                });
+        }
+        if constexpr (can_prefetch<json_T, is_file>()) {
+            if (use_prefetch(json, parse_opts)) {
+                return prefetch_parse_and_deserialize<parse_error_ok>(
+                    parser,
+                    json,
+                    on_parse_error,
+                    parse_opts,
+                    [&parse_opts](simdjson::dom::element parsed) {
+                        return deserialize(parsed, parse_opts);
+                    });
+            }
+        }
+
         const R_xlen_t n = std::size(json);
         Rcpp::List     out(n);
 
@@ -574,78 +839,62 @@ template <typename json_T,
           bool is_single_query,
           bool parse_error_ok,
           bool query_error_ok>
-inline SEXP flat_query(const json_T&                                json,
+inline SEXP flat_query(simdjson::dom::parser&                       parser,
+                       const json_T&                                json,
                        const Rcpp::CharacterVector&                 query,
                        SEXP                                         on_parse_error,
                        SEXP                                         on_query_error,
                        const rcppsimdjson::deserialize::Parse_Opts& parse_opts) {
-    simdjson::dom::parser parser;
-
     if constexpr (is_single_json) {
         if constexpr (is_single_query) {
             return parse_query_and_deserialize<json_T, is_file, parse_error_ok, query_error_ok>(
                 parser, json, query[0], on_parse_error, on_query_error, parse_opts);
 
         } else { /* !single_query */
-            const R_xlen_t n = std::size(query);
-            Rcpp::List     out(n);
-
-            if constexpr (parse_error_ok) {
-                simdjson::dom::element parsed;
-                if(simdjson::SUCCESS == parse<json_T, is_file>(parser, json).get(parsed)) {
-                    for (R_xlen_t i = 0; i < n; ++i) {				// #nocov start
-                        out[i] = query_and_deserialize<query_error_ok>(
-                            parsed, query[i], on_query_error, parse_opts);
-                    }
-                    out.attr("names") = query.attr("names");
-                    return out;							// #nocov end
-                }
-                return on_parse_error;
+            return parse_queries_and_deserialize<json_T, is_file, parse_error_ok, query_error_ok>(
+                parser, json, query, on_parse_error, on_query_error, parse_opts);
+        }
 
-            } else { /* !parse_error_ok */
-                simdjson::dom::element parsed;
-                auto error = parse<json_T, is_file>(parser, json).get(parsed);
-                if (error != simdjson::SUCCESS) {
-                    Rcpp::stop(simdjson::error_message(error));
-                }
-                for (R_xlen_t i = 0; i < n; ++i) {
-                    out[i] = query_and_deserialize<query_error_ok>(
-                        parsed, query[i], on_query_error, parse_opts);
-                }
-                out.attr("names") = query.attr("names");
-                return out;
+    } else { /* !single_json */
+        /* the query (or queries) of each document, once parsed */
+        const auto query_parsed = [&query, on_query_error, &parse_opts](
+                                      simdjson::dom::element parsed) -> SEXP {
+            if constexpr (is_single_query) {
+                return query_and_deserialize<query_error_ok>(
+                    parsed, query[0], on_query_error, parse_opts);
+            } else {
+                return query_all_and_deserialize<query_error_ok>(
+                    parsed, query, on_query_error, parse_opts);
+            }
+        };
+
+        if (parse_opts.threads > 1) {
+            return parallel_parse_and_deserialize<json_T, is_file, parse_error_ok>(
+                json, on_parse_error, parse_opts, query_parsed);
+        }
+        if constexpr (can_prefetch<json_T, is_file>()) {
+            if (use_prefetch(json, parse_opts)) {
+                return prefetch_parse_and_deserialize<parse_error_ok>(
+                    parser, json, on_parse_error, parse_opts, query_parsed);
             }
         }
 
-    } else { /* !single_json */
         const R_xlen_t n = std::size(json);
         Rcpp::List     out(n);
 
-        if constexpr (is_single_query) {
-            for (R_xlen_t i = 0; i < n; ++i) {
+        for (R_xlen_t i = 0; i < n; ++i) {
+            if constexpr (is_single_query) {
                 out[i] = parse_query_and_deserialize<decltype(json[i]),
                                                      is_file,
                                                      parse_error_ok,
                                                      query_error_ok>(
                     parser, json[i], query[0], on_parse_error, on_query_error, parse_opts);
-            }
-            out.attr("names") = json.attr("names");
-            return out;
-
-        } else { /* !single_query */
-            for (R_xlen_t i = 0; i < n; ++i) {
-                const R_xlen_t n_queries = std::size(query);
-                Rcpp::List     res(n_queries);
-
-                for (R_xlen_t j = 0; j < n_queries; ++j) {
-                    res[j] = parse_query_and_deserialize<decltype(json[i]),
-                                                         is_file,
-                                                         parse_error_ok,
-                                                         query_error_ok>(
-                        parser, json[i], query[j], on_parse_error, on_query_error, parse_opts);
-                }
-                res.attr("names") = query.attr("names");
-                out[i]            = res;
+            } else {
+                out[i] = parse_queries_and_deserialize<decltype(json[i]),
+                                                       is_file,
+                                                       parse_error_ok,
+                                                       query_error_ok>(
+                    parser, json[i], query, on_parse_error, on_query_error, parse_opts);
             }
         }
 
@@ -661,81 +910,59 @@ template <typename json_T,
           bool is_single_query,
           bool parse_error_ok,
           bool query_error_ok>
-inline SEXP nested_query(const json_T&                                json,
+inline SEXP nested_query(simdjson::dom::parser&                       parser,
+                         const json_T&                                json,
                          const Rcpp::ListOf<Rcpp::CharacterVector>&   query,
                          SEXP                                         on_parse_error,
                          SEXP                                         on_query_error,
                          const rcppsimdjson::deserialize::Parse_Opts& parse_opts) {
-    const R_xlen_t        n = std::size(json); /* query already checked to be the same size */
-    Rcpp::List            out(n);
-    simdjson::dom::parser parser;
+    const R_xlen_t n = std::size(query); /* json already checked to be the same size */
+    Rcpp::List     out(n);
 
     if constexpr (is_single_json) {
-        if constexpr (parse_error_ok) {
-            simdjson::dom::element parsed;
-            if(simdjson::SUCCESS == parse<json_T, is_file>(parser, json).get(parsed)) {
-                for (R_xlen_t i = 0; i < n; ++i) {
-                    const R_xlen_t n_queries = std::size(query[i]);
-                    Rcpp::List     res(n_queries);
-                    for (R_xlen_t j = 0; j < n_queries; ++j) {
-                        res[j] = query_and_deserialize<query_error_ok>(
-                            parsed, query[i][j], on_query_error, parse_opts);
-                    }
-                    res.attr("names") = query[i].attr("names");
-                    out[i]            = res;
+        if (parse_opts.ondemand_parser) {
+            /* one iteration of `json` for every query, as with the DOM below */
+            Ondemand_Doc doc;
+            auto         parse_failed = false;
+            if (const auto error = doc.load<json_T, is_file>(
+                    *parse_opts.ondemand_parser, json, parse_opts.use_mmap);
+                error) {
+                if constexpr (parse_error_ok) {
+                    return on_parse_error;
+                } else {
+                    Rcpp::stop(simdjson::error_message(error)); // #nocov
                 }
             }
-
-            return on_parse_error;
-
-        } else { /* !parse_error_ok */
+            for (R_xlen_t i = 0; i < n && !parse_failed; ++i) {
+                out[i] = ondemand_query_all_and_deserialize<parse_error_ok, query_error_ok>(
+                    parser, doc, query[i], on_query_error, parse_opts, parse_failed);
+            }
+            if (parse_failed) {
+                return on_parse_error;
+            }
+        } else {
             simdjson::dom::element parsed;
-            auto error = parse<json_T, is_file>(parser, json).get(parsed); // #nocov
+            auto error = parse<json_T, is_file>(parser, json, parse_opts).get(parsed);
             if (error != simdjson::SUCCESS) {
-                Rcpp::stop(simdjson::error_message(error));			// #nocov
+                if constexpr (parse_error_ok) {
+                    return on_parse_error;
+                } else {
+                    Rcpp::stop(simdjson::error_message(error)); // #nocov
+                }
             }
             for (R_xlen_t i = 0; i < n; ++i) {
-                const R_xlen_t n_queries = std::size(query[i]);
-                Rcpp::List     res(n_queries);
-                for (R_xlen_t j = 0; j < n_queries; ++j) {
-                    res[j] = query_and_deserialize<query_error_ok>(
-                        parsed, query[i][j], on_query_error, parse_opts);
-                }
-                res.attr("names") = query[i].attr("names");
-                out[i]            = res;
+                out[i] = query_all_and_deserialize<query_error_ok>(
+                    parsed, query[i], on_query_error, parse_opts);
             }
         }
 
     } else { /* !is_single_json */
         for (R_xlen_t i = 0; i < n; ++i) {
-            const R_xlen_t n_queries = std::size(query[i]);
-            if constexpr (parse_error_ok) {
-                simdjson::dom::element parsed;
-                if(simdjson::SUCCESS == parse<decltype(json[i]), is_file>(parser, json[i]).get(parsed)) {
-                    Rcpp::List res(n_queries);						// #nocov start
-                    for (R_xlen_t j = 0; j < n_queries; ++j) {
-                        res[j] = query_and_deserialize<query_error_ok>(
-                            parsed, query[i][j], on_query_error, parse_opts);
-                    }
-                    res.attr("names") = query[i].attr("names");
-                    out[i]            = res;						// #nocov end
-                }
-                out[i] = on_parse_error;
-
-            } else { /* !parse_error_ok */
-                simdjson::dom::element parsed;
-                auto error = parse<decltype(json[i]), is_file>(parser, json[i]).get(parsed);
-                if (error != simdjson::SUCCESS) {
-                    Rcpp::stop(simdjson::error_message(error));
-                }
-                Rcpp::List res(n_queries);
-                for (R_xlen_t j = 0; j < n_queries; ++j) {
-                    res[j] = query_and_deserialize<query_error_ok>(
-                        parsed, query[i][j], on_query_error, parse_opts);
-                }
-                res.attr("names") = query[i].attr("names");
-                out[i]            = res;
-            }
+            out[i] = parse_queries_and_deserialize<decltype(json[i]),
+                                                   is_file,
+                                                   parse_error_ok,
+                                                   query_error_ok>(
+                parser, json[i], query[i], on_parse_error, on_query_error, parse_opts);
         }
     }
 
@@ -753,8 +980,12 @@ template <bool is_file,
           bool is_single_query,
           bool parse_error_ok,
           bool query_error_ok>
-inline SEXP dispatch_deserialize(
-    SEXP json, SEXP query, SEXP on_parse_error, SEXP on_query_error, const Parse_Opts& parse_opts) {
+inline SEXP dispatch_deserialize(simdjson::dom::parser& parser,
+                                 SEXP                   json,
+                                 SEXP                   query,
+                                 SEXP                   on_parse_error,
+                                 SEXP                   on_query_error,
+                                 const Parse_Opts&      parse_opts) {
 
     switch (TYPEOF(json)) {
         case STRSXP: {
@@ -764,7 +995,7 @@ inline SEXP dispatch_deserialize(
                                     is_file,
                                     is_single_json,
                                     parse_error_ok,
-                                    query_error_ok>(json, on_parse_error, parse_opts);
+                                    query_error_ok>(parser, json, on_parse_error, parse_opts);
 
                 case STRSXP:
                     return flat_query<Rcpp::CharacterVector,
@@ -773,7 +1004,7 @@ inline SEXP dispatch_deserialize(
                                       is_single_query,
                                       parse_error_ok,
                                       query_error_ok>(
-                        json, query, on_parse_error, on_query_error, parse_opts);
+                        parser, json, query, on_parse_error, on_query_error, parse_opts);
 
                 case VECSXP:
                     return nested_query<Rcpp::CharacterVector,
@@ -782,7 +1013,7 @@ inline SEXP dispatch_deserialize(
                                         NOT_SINGLE_QUERY, /* VECSXP query always NOT_SINGLE_QUERY */
                                         parse_error_ok,
                                         query_error_ok>(
-                        json, query, on_parse_error, on_query_error, parse_opts);
+                        parser, json, query, on_parse_error, on_query_error, parse_opts);
 
                 default:							// #nocov
                     return R_NilValue;						// #nocov
@@ -796,7 +1027,7 @@ inline SEXP dispatch_deserialize(
                                     is_file,
                                     SINGLE_JSON, /* RAWSXP json must be SINGLE_JSON */
                                     parse_error_ok,
-                                    query_error_ok>(json, on_parse_error, parse_opts);
+                                    query_error_ok>(parser, json, on_parse_error, parse_opts);
 
                 case STRSXP:
                     return flat_query<Rcpp::RawVector,
@@ -805,7 +1036,7 @@ inline SEXP dispatch_deserialize(
                                       is_single_query,
                                       parse_error_ok,
                                       query_error_ok>(
-                        json, query, on_parse_error, on_query_error, parse_opts);
+                        parser, json, query, on_parse_error, on_query_error, parse_opts);
 
                 case VECSXP:								// #nocov start
                     return nested_query<Rcpp::RawVector,
@@ -814,7 +1045,7 @@ inline SEXP dispatch_deserialize(
                                         NOT_SINGLE_QUERY, /* VECSXP query always NOT_SINGLE_QUERY */
                                         parse_error_ok,
                                         query_error_ok>(
-                        json, query, on_parse_error, on_query_error, parse_opts);
+                        parser, json, query, on_parse_error, on_query_error, parse_opts);
 
                 default:
                     return R_NilValue;							// #nocov end
@@ -828,7 +1059,7 @@ inline SEXP dispatch_deserialize(
                                     is_file,
                                     NOT_SINGLE_JSON, /* VECSXP json always NOT_SINGLE_JSON */
                                     parse_error_ok,
-                                    query_error_ok>(json, on_parse_error, parse_opts);
+                                    query_error_ok>(parser, json, on_parse_error, parse_opts);
 
                 case STRSXP:
                     return flat_query<Rcpp::ListOf<Rcpp::RawVector>,
@@ -837,7 +1068,7 @@ inline SEXP dispatch_deserialize(
                                       is_single_query,
                                       parse_error_ok,
                                       query_error_ok>(
-                        json, query, on_parse_error, on_query_error, parse_opts);
+                        parser, json, query, on_parse_error, on_query_error, parse_opts);
 
                 case VECSXP:							// #nocov start
                     return nested_query<Rcpp::ListOf<Rcpp::RawVector>,
@@ -846,7 +1077,7 @@ inline SEXP dispatch_deserialize(
                                         NOT_SINGLE_QUERY, /* VECSXP query always NOT_SINGLE_QUERY */
                                         parse_error_ok,
                                         query_error_ok>(
-                        json, query, on_parse_error, on_query_error, parse_opts);
+                        parser, json, query, on_parse_error, on_query_error, parse_opts);
 
                 default:
                     return R_NilValue;
@@ -860,6 +1091,34 @@ inline SEXP dispatch_deserialize(
 }
 
 
+/**
+ * @brief The simdjson::dom::parser behind a `simdjson_parser()` external pointer, or `fallback`
+ * if `parser_ptr` is `NULL`.
+ */
+inline simdjson::dom::parser& resolve_parser(SEXP parser_ptr, simdjson::dom::parser& fallback) {
+    if (Rf_isNull(parser_ptr)) {
+        return fallback;
+    }
+    if (TYPEOF(parser_ptr) != EXTPTRSXP || !Rf_inherits(parser_ptr, "simdjson_parser")) {
+        Rcpp::stop("`parser=` must be `NULL` or created by `simdjson_parser()`.");
+    }
+    return *Rcpp::XPtr<simdjson::dom::parser>(parser_ptr).checked_get();
+}
+
+
+/**
+ * @brief `threads`, clamped to the number of threads OpenMP may use (1 without OpenMP).
+ */
+inline auto resolve_threads(const int threads) noexcept -> int {
+#ifdef _OPENMP
+    return std::clamp(threads, 1, std::max(omp_get_max_threads(), 1));
+#else
+    static_cast<void>(threads);
+    return 1;
+#endif
+}
+
+
 template <bool is_file, bool is_single_json, bool is_single_query>
 inline SEXP start(SEXP       json,
                   SEXP       query,
@@ -872,13 +1131,59 @@ inline SEXP start(SEXP       json,
                   SEXP       on_query_error,
                   const int  simplify_to,
                   const int  type_policy,
-                  const int  int64_r_type) {
-    const auto parse_opts = Parse_Opts{static_cast<Simplify_To>(simplify_to),
-                                       static_cast<Type_Policy>(type_policy),
-                                       static_cast<utils::Int64_R_Type>(int64_r_type),
-                                       empty_array,
-                                       empty_object,
-                                       single_null};
+                  const int  int64_r_type,
+                  const int  threads           = 1,
+                  SEXP       parser_ptr        = R_NilValue,
+                  const bool use_mmap          = false,
+                  SEXP       schema            = R_NilValue,
+                  SEXP       select            = R_NilValue,
+                  const int  engine            = 0,
+                  const bool lazy_strings      = false,
+                  const int  max_factor_levels = 0,
+                  const int  output            = 0,
+                  SEXP       tape_cache        = R_NilValue) {
+    /* compiled once, then shared by every document */
+    auto compiled_schema = std::optional<Schema>();
+    if (!Rf_isNull(schema)) {
+        compiled_schema.emplace(schema);
+    }
+    auto compiled_selection = std::optional<Selection>();
+    if (!Rf_isNull(select)) {
+        compiled_selection.emplace(select);
+    }
+    simdjson::ondemand::parser ondemand_parser; /* allocates nothing until it's used */
+
+    auto parse_opts = Parse_Opts{static_cast<Simplify_To>(simplify_to),
+                                 static_cast<Type_Policy>(type_policy),
+                                 static_cast<utils::Int64_R_Type>(int64_r_type),
+                                 empty_array,
+                                 empty_object,
+                                 single_null,
+                                 resolve_threads(threads),
+                                 use_mmap,
+                                 compiled_schema ? &*compiled_schema : nullptr,
+                                 compiled_selection ? &*compiled_selection : nullptr,
+                                 static_cast<Engine>(engine) == Engine::ondemand ? &ondemand_parser
+                                                                                 : nullptr,
+                                 max_factor_levels,
+                                 static_cast<Output>(output)};
+
+    simdjson::dom::parser  local_parser;
+    simdjson::dom::parser& parser = resolve_parser(parser_ptr, local_parser);
+
+    /* documents parsed into this outlive `parser` (see Lazy_Strings) */
+    auto lazy = std::optional<Lazy_Strings>();
+    if (lazy_strings && Lazy_Strings::is_available()) {
+        lazy.emplace();
+        parse_opts.lazy_strings = &*lazy;
+    }
+
+    /* files' tapes are saved to (and loaded from) this directory */
+    auto cache = std::optional<Tape_Cache>();
+    if (!Rf_isNull(tape_cache)) {
+        cache.emplace(Rcpp::as<std::string>(tape_cache));
+        parse_opts.tape_cache = &*cache;
+    }
 
     if (parse_error_ok) {
         return query_error_ok ? dispatch_deserialize<is_file,
@@ -886,26 +1191,46 @@ inline SEXP start(SEXP       json,
                                                      is_single_query,
                                                      PARSE_ERROR_OK,
                                                      QUERY_ERROR_OK>(
-                                    json, query, on_parse_error, on_query_error, parse_opts)
+                                    parser,
+                                    json,
+                                    query,
+                                    on_parse_error,
+                                    on_query_error,
+                                    parse_opts)
                               : dispatch_deserialize<is_file,
                                                      is_single_json,
                                                      is_single_query,
                                                      PARSE_ERROR_OK,
                                                      QUERY_ERROR_NOT_OK>(
-                                    json, query, on_parse_error, on_query_error, parse_opts);
+                                    parser,
+                                    json,
+                                    query,
+                                    on_parse_error,
+                                    on_query_error,
+                                    parse_opts);
     } else { /* !parse_error_ok*/
         return query_error_ok ? dispatch_deserialize<is_file,
                                                      is_single_json,
                                                      is_single_query,
                                                      PARSE_ERROR_NOT_OK,
                                                      QUERY_ERROR_OK>(
-                                    json, query, on_parse_error, on_query_error, parse_opts)
+                                    parser,
+                                    json,
+                                    query,
+                                    on_parse_error,
+                                    on_query_error,
+                                    parse_opts)
                               : dispatch_deserialize<is_file,
                                                      is_single_json,
                                                      is_single_query,
                                                      PARSE_ERROR_NOT_OK,
                                                      QUERY_ERROR_NOT_OK>(
-                                    json, query, on_parse_error, on_query_error, parse_opts);
+                                    parser,
+                                    json,
+                                    query,
+                                    on_parse_error,
+                                    on_query_error,
+                                    parse_opts);
     }
 }
 
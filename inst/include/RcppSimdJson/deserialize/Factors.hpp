@@ -0,0 +1,116 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__FACTORS_HPP
+#define RCPPSIMDJSON__DESERIALIZE__FACTORS_HPP
+
+#include "Lazy_Strings.hpp"
+#include "String_Cache.hpp"
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief Hash table assigning (1-based) factor codes to strings in order of first appearance.
+ *
+ * Keys are views into the simdjson document, so a Factor_Builder must not outlive it. Each level
+ * becomes a CHARSXP once, when the factor (or, past `Parse_Opts::max_factor_levels`, the character
+ * vector) is made.
+ *
+ * Once past `max_factor_levels`, the builder has failed: its hash table is dropped and each string
+ * is only appended, as a level of its own, for the character vector it will finish as.
+ */
+class Factor_Builder {
+    std::unordered_map<std::string_view, int> codes_;
+    std::vector<std::string_view>             levels_;
+    String_Cache*                             string_cache_;
+    int                                       max_levels_;
+    Lazy_Strings*                             lazy_strings_;
+    bool                                      failed_ = false;
+
+  public:
+    explicit Factor_Builder(const Parse_Opts& parse_opts)
+        : string_cache_(parse_opts.string_cache), max_levels_(parse_opts.max_factor_levels),
+          lazy_strings_(parse_opts.lazy_strings) {}
+
+    [[nodiscard]] auto code(const std::string_view str) -> int {
+        if (failed_) {
+            levels_.push_back(str);
+            return static_cast<int>(std::size(levels_));
+        }
+
+        const auto [it, is_new] = codes_.try_emplace(str, static_cast<int>(std::size(levels_)) + 1);
+        const auto code         = it->second;
+        if (is_new) {
+            levels_.push_back(str);
+            if (std::size(levels_) > static_cast<std::size_t>(max_levels_)) {
+                failed_ = true;
+                codes_  = decltype(codes_)();
+            }
+        }
+        return code;
+    }
+
+    [[nodiscard]] auto n_levels() const noexcept -> std::size_t { return std::size(levels_); }
+
+    [[nodiscard]] auto fits() const noexcept -> bool { return !failed_; }
+
+    /**
+     * @brief Turn `codes` (`NA_INTEGER` for `null`s) into a factor, or into the equivalent
+     * character vector if there are too many levels.
+     */
+    auto finish(Rcpp::IntegerVector codes) -> SEXP {
+        if (!fits()) {
+            return as_character(codes);
+        }
+
+        auto levels = Rcpp::CharacterVector(n_levels());
+        for (R_xlen_t i = 0; i < std::size(levels); ++i) {
+            levels[i] = make_charsxp(levels_[i], string_cache_);
+        }
+        codes.attr("levels") = levels;
+        codes.attr("class")  = "factor";
+
+        return codes;
+    }
+
+  private:
+    auto as_character(const Rcpp::IntegerVector& codes) -> SEXP {
+        const auto n = std::size(codes);
+
+        if (lazy_strings_) {
+            auto strings = std::vector<std::string_view>(n);
+            for (auto& level : levels_) {
+                level = Lazy_Strings::view(level);
+            }
+            for (R_xlen_t i = 0; i < n; ++i) {
+                if (codes[i] != NA_INTEGER) {
+                    strings[i] = levels_[codes[i] - 1];
+                }
+            }
+            return make_lazy_strings(std::move(strings), *lazy_strings_);
+        }
+
+        auto levels = Rcpp::CharacterVector(n_levels());
+        for (R_xlen_t i = 0; i < std::size(levels); ++i) {
+            levels[i] = make_charsxp(levels_[i], string_cache_);
+        }
+        auto out = Rcpp::CharacterVector(n, NA_STRING);
+        for (R_xlen_t i = 0; i < n; ++i) {
+            if (codes[i] != NA_INTEGER) {
+                SET_STRING_ELT(out, i, STRING_ELT(levels, codes[i] - 1));
+            }
+        }
+        return out;
+    }
+};
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__LAZY_STRINGS_HPP
+#define RCPPSIMDJSON__DESERIALIZE__LAZY_STRINGS_HPP
+
+#include "../common.hpp"
+
+#include <Rversion.h>
+#if R_VERSION >= R_Version(3, 6, 0)
+#    define RCPPSIMDJSON_HAVE_ALTREP 1
+#    include <R_ext/Altrep.h>
+#endif
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+namespace lazy_strings {
+
+
+/**
+ * @brief ALTREP character vectors whose elements are views into a parsed document's string
+ * buffer, only turned into CHARSXPs when R asks for them.
+ *
+ * - data1: external pointer to the `std::vector<std::string_view>` of elements (a view without
+ *   data is `NA`), which protects the external pointer owning the document (see Lazy_Strings).
+ * - data2: `NULL`, or the materialized (regular) character vector.
+ *
+ * `Elt()` makes a single CHARSXP. Anything needing the whole vector at once (`DATAPTR()`, setting
+ * an element, serializing) materializes it, after which the views (and possibly the document) are
+ * released.
+ *
+ * Methods are called from R's C code, so they must never throw: strings are checked for embedded
+ * NULs when the views are collected (see `Lazy_Strings::view()`), not here.
+ */
+#ifdef RCPPSIMDJSON_HAVE_ALTREP
+inline R_altrep_class_t altrep_class;
+inline bool             is_registered = false;
+
+
+inline auto views(SEXP x) -> const std::vector<std::string_view>& {
+    return *static_cast<std::vector<std::string_view>*>(R_ExternalPtrAddr(R_altrep_data1(x)));
+}
+
+
+inline auto make(const std::string_view str) -> SEXP {
+    return str.data() == nullptr
+               ? NA_STRING
+               : Rf_mkCharLenCE(std::data(str), static_cast<int>(std::size(str)), CE_UTF8);
+}
+
+
+inline auto materialize(SEXP x) -> SEXP {
+    if (SEXP strings = R_altrep_data2(x); strings != R_NilValue) {
+        return strings;
+    }
+
+    const auto&    strs = views(x);
+    const R_xlen_t n    = static_cast<R_xlen_t>(std::size(strs));
+    SEXP           out  = PROTECT(Rf_allocVector(STRSXP, n));
+    for (R_xlen_t i = 0; i < n; ++i) {
+        SET_STRING_ELT(out, i, make(strs[i]));
+    }
+    R_set_altrep_data2(x, out);
+    R_set_altrep_data1(x, R_NilValue); /* let the document go */
+    UNPROTECT(1);
+
+    return out;
+}
+
+
+inline R_xlen_t length_method(SEXP x) {
+    if (SEXP strings = R_altrep_data2(x); strings != R_NilValue) {
+        return Rf_xlength(strings);
+    }
+    return static_cast<R_xlen_t>(std::size(views(x)));
+}
+
+inline SEXP elt_method(SEXP x, R_xlen_t i) {
+    if (SEXP strings = R_altrep_data2(x); strings != R_NilValue) {
+        return STRING_ELT(strings, i);
+    }
+    return make(views(x)[i]);
+}
+
+inline void set_elt_method(SEXP x, R_xlen_t i, SEXP value) {
+    SET_STRING_ELT(materialize(x), i, value);
+}
+
+inline void* dataptr_method(SEXP x, Rboolean /* writeable */) {
+    return const_cast<SEXP*>(STRING_PTR_RO(materialize(x)));
+}
+
+inline const void* dataptr_or_null_method(SEXP x) {
+    SEXP strings = R_altrep_data2(x);
+    return strings == R_NilValue ? nullptr : STRING_PTR_RO(strings);
+}
+
+/* serialized as a regular character vector, so documents are never written out */
+inline SEXP serialized_state_method(SEXP x) { return materialize(x); }
+
+inline SEXP unserialize_method(SEXP /* altrep_class */, SEXP state) { return state; }
+
+
+/**
+ * @brief Register the ALTREP class. Called once, from `R_init_RcppSimdJson()`.
+ */
+inline void init(DllInfo* dll) {
+    altrep_class = R_make_altstring_class("lazy_strings", "RcppSimdJson", dll);
+
+    R_set_altrep_Length_method(altrep_class, length_method);
+    R_set_altrep_Serialized_state_method(altrep_class, serialized_state_method);
+    R_set_altrep_Unserialize_method(altrep_class, unserialize_method);
+    R_set_altvec_Dataptr_method(altrep_class, dataptr_method);
+    R_set_altvec_Dataptr_or_null_method(altrep_class, dataptr_or_null_method);
+    R_set_altstring_Elt_method(altrep_class, elt_method);
+    R_set_altstring_Set_elt_method(altrep_class, set_elt_method);
+
+    is_registered = true;
+}
+#else
+inline constexpr bool is_registered = false;
+
+inline void init(DllInfo*) {}
+#endif
+
+
+} // namespace lazy_strings
+
+
+/**
+ * @brief Keeps parsed documents alive for character vectors whose strings are materialized when R
+ * first reads them rather than while deserializing.
+ *
+ * While a Lazy_Strings is set in `Parse_Opts::lazy_strings`, documents are parsed into one it
+ * allocates (see `new_document()`) instead of the parser's own, so their string buffers outlive
+ * the parser. `chr` vectors and homogeneous `chr` data frame columns are then built by
+ * `make_lazy_strings()` from views into that document, which each of them keeps alive until it is
+ * materialized or garbage collected.
+ *
+ * `start()` only sets one if the ALTREP class was registered (by this package's
+ * `R_init_RcppSimdJson()`, see `is_available()`), so code built against these headers elsewhere
+ * keeps getting regular character vectors.
+ */
+class Lazy_Strings {
+    Rcpp::RObject document_; /* external pointer owning the document being deserialized */
+
+  public:
+    Lazy_Strings() = default;
+
+    Lazy_Strings(const Lazy_Strings&) = delete;
+    Lazy_Strings& operator=(const Lazy_Strings&) = delete;
+
+    [[nodiscard]] static auto is_available() noexcept -> bool {
+        return lazy_strings::is_registered;
+    }
+
+    /**
+     * @brief A new, empty document for the parser to fill, owned by the strings built from it.
+     */
+    [[nodiscard]] auto new_document() -> simdjson::dom::document& {
+        auto document = Rcpp::XPtr<simdjson::dom::document>(new simdjson::dom::document());
+        document_     = document;
+        return *document;
+    }
+
+    /**
+     * @brief Take over an already parsed `document` (leaving it empty), returning its root.
+     */
+    auto adopt(simdjson::dom::document& document) -> simdjson::dom::element {
+        auto& owned = new_document();
+        owned       = std::move(document);
+        /* a moved-from document keeps its capacity, so it must be reset before it's reused */
+        document = simdjson::dom::document();
+        return owned.root();
+    }
+
+    [[nodiscard]] auto document() const noexcept -> SEXP { return document_; }
+
+    /** @brief `str`, checked as `make_charsxp()` would before it is kept for later. */
+    [[nodiscard]] static auto view(const std::string_view str) -> std::string_view {
+        if (std::memchr(std::data(str), '\0', std::size(str)) != nullptr) {
+            Rcpp::stop("Embedded NUL in string.");
+        }
+        return str;
+    }
+};
+
+
+/**
+ * @brief A lazy character vector of `strings` (views without data are `NA`), which must be views
+ * (from `Lazy_Strings::view()`) into `lazy`'s current document.
+ */
+inline auto make_lazy_strings(std::vector<std::string_view>&& strings, const Lazy_Strings& lazy)
+    -> SEXP {
+#ifdef RCPPSIMDJSON_HAVE_ALTREP
+    auto* const views = new std::vector<std::string_view>(std::move(strings));
+    const auto  data1 =
+        Rcpp::XPtr<std::vector<std::string_view>>(views, true, R_NilValue, lazy.document());
+    return R_new_altrep(lazy_strings::altrep_class, data1, R_NilValue);
+#else
+    static_cast<void>(strings);
+    static_cast<void>(lazy);
+    return R_NilValue; /* never available */
+#endif
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__STRING_CACHE_HPP
+#define RCPPSIMDJSON__DESERIALIZE__STRING_CACHE_HPP
+
+#include "../common.hpp"
+
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief Interning table mapping a document's strings to their CHARSXPs.
+ *
+ * Record arrays repeat the same keys and enum-like values many times. Given a String_Cache,
+ * `make_charsxp()` looks each string up here first, so a repeated string costs one hash lookup
+ * instead of a `std::string` allocation plus a lookup in R's global CHARSXP cache.
+ *
+ * Keys are views into the simdjson document's string buffer, so a cache must not outlive the
+ * document being deserialized: `deserialize()` creates one per call and hands it down through
+ * `Parse_Opts::string_cache`. Cached CHARSXPs are kept alive by protected chunks until the cache is
+ * destroyed.
+ */
+class String_Cache {
+    static constexpr std::size_t MAX_CACHED_SIZE = 128;     /* longer strings rarely repeat */
+    static constexpr std::size_t MAX_ENTRIES     = 1 << 16; /* bound the memory held per call */
+    static constexpr R_xlen_t    CHUNK_SIZE      = 4096;
+
+    std::unordered_map<std::string_view, SEXP> charsxps_;
+    std::vector<Rcpp::CharacterVector>         chunks_;
+    R_xlen_t                                   n_in_chunk_ = CHUNK_SIZE;
+
+  public:
+    String_Cache() = default;
+
+    String_Cache(const String_Cache&) = delete;
+    String_Cache& operator=(const String_Cache&) = delete;
+
+    [[nodiscard]] static auto make(const std::string_view str) -> SEXP {
+        if (std::memchr(std::data(str), '\0', std::size(str)) != nullptr) {
+            Rcpp::stop("Embedded NUL in string.");
+        }
+        return Rf_mkCharLenCE(std::data(str), static_cast<int>(std::size(str)), CE_UTF8);
+    }
+
+    auto get(const std::string_view str) -> SEXP {
+        if (std::size(str) > MAX_CACHED_SIZE) {
+            return make(str);
+        }
+        if (const auto it = charsxps_.find(str); it != std::end(charsxps_)) {
+            return it->second;
+        }
+        if (std::size(charsxps_) >= MAX_ENTRIES) {
+            return make(str);
+        }
+
+        /* reserve the protected slot first, as allocating a chunk may trigger a GC */
+        if (n_in_chunk_ == CHUNK_SIZE) {
+            chunks_.emplace_back(CHUNK_SIZE);
+            n_in_chunk_ = 0;
+        }
+        const auto out = make(str);
+        SET_STRING_ELT(chunks_.back(), n_in_chunk_++, out);
+        charsxps_.emplace(str, out);
+
+        return out;
+    }
+};
+
+
+/**
+ * @brief The (UTF-8) CHARSXP for `str`, interned by `string_cache` if any.
+ *
+ * The result is unprotected unless it came from the cache: it must be stored (e.g. via
+ * `SET_STRING_ELT()`) before anything else allocates.
+ */
+inline auto make_charsxp(const std::string_view str, String_Cache* const string_cache) -> SEXP {
+    return string_cache ? string_cache->get(str) : String_Cache::make(str);
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
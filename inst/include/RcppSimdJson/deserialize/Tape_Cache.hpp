@@ -0,0 +1,473 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__TAPE_CACHE_HPP
+#define RCPPSIMDJSON__DESERIALIZE__TAPE_CACHE_HPP
+
+#include "../mapped_file.hpp"
+
+#include <algorithm>   /* std::max, std::min */
+#include <atomic>      /* std::atomic */
+#include <cstddef>     /* offsetof */
+#include <cstdint>     /* std::uint64_t */
+#include <cstdio>      /* std::FILE, std::fopen, std::fwrite, std::rename */
+#include <cstring>     /* std::memcpy, std::memcmp */
+#include <memory>      /* std::unique_ptr */
+#include <optional>    /* std::optional */
+#include <string>      /* std::string */
+#include <string_view> /* std::string_view */
+#include <type_traits> /* std::is_same_v */
+#include <utility>     /* std::pair */
+#include <vector>      /* std::vector */
+
+#include <sys/stat.h> /* stat */
+#ifdef _WIN32
+#    include <process.h> /* _getpid */
+#else
+#    include <unistd.h> /* getpid */
+#endif
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+namespace tape_cache {
+
+
+/*
+ * Tapes are saved and walked as simdjson lays them out: a document owning its tape and string
+ * buffer as `unique_ptr<T[]>`s, tape words holding a type in their top byte and a value or offset
+ * in the rest. Should a simdjson upgrade change any of that, these fail to compile and
+ * `Header::TAPE_LAYOUT` must be bumped along with the code, so that older tapes are rejected.
+ */
+static_assert(simdjson::SIMDJSON_VERSION_MAJOR == 3, "tape layout checked for simdjson 3");
+static_assert(simdjson::internal::JSON_VALUE_MASK == 0x00FFFFFFFFFFFFFF, "tape words changed");
+static_assert(std::is_same_v<decltype(simdjson::dom::document::tape),
+                             std::unique_ptr<std::uint64_t[]>>,
+              "document tapes changed");
+static_assert(std::is_same_v<decltype(simdjson::dom::document::string_buf),
+                             std::unique_ptr<std::uint8_t[]>>,
+              "document string buffers changed");
+
+
+/**
+ * @brief A fast (not cryptographic) 64-bit hash.
+ */
+class Hasher {
+    std::uint64_t hash_ = 0x9E3779B97F4A7C15;
+
+    static constexpr std::uint64_t MULTIPLIER = 0xFF51AFD7ED558CCD;
+
+  public:
+    void update(const char* data, const std::size_t size) noexcept {
+        auto i = std::size_t(0);
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            hash_ = (hash_ ^ word) * MULTIPLIER;
+            hash_ ^= hash_ >> 29;
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, data + i, size - i);
+        hash_ = (hash_ ^ tail ^ size) * MULTIPLIER;
+        hash_ ^= hash_ >> 32;
+    }
+
+    [[nodiscard]] auto hash() const noexcept -> std::uint64_t { return hash_; }
+};
+
+
+inline auto hash_string(const std::string_view str) noexcept -> std::uint64_t {
+    auto hasher = Hasher();
+    hasher.update(std::data(str), std::size(str));
+    return hasher.hash();
+}
+
+
+/**
+ * @brief A hash of the first and last `EDGE` bytes of `size` bytes at `data` (all of them if
+ * there are fewer), which catches truncated or partly overwritten tapes without reading them
+ * whole.
+ */
+inline auto hash_edges(const char* data, const std::size_t size) noexcept -> std::uint64_t {
+    constexpr auto EDGE = std::size_t(1) << 12;
+
+    auto hasher = Hasher();
+    if (size <= 2 * EDGE) {
+        hasher.update(data, size);
+    } else {
+        hasher.update(data, EDGE);
+        hasher.update(data + size - EDGE, EDGE);
+    }
+    return hasher.hash();
+}
+
+
+/**
+ * @brief What a tape file starts with: what it was made from and by, and the size and checksum of
+ * its parts.
+ *
+ * It's followed by the source's path (padded to 8 bytes), the tape, and the string buffer. A tape
+ * is only checked as far as its header, its root words and the edges of its parts (see
+ * `hash_edges()`): checking every byte would cost about as much as parsing the source again.
+ */
+struct Header {
+    char          magic[16];
+    std::uint64_t byte_order; /* ENDIAN_MARK as written, so that foreign files are rejected */
+    std::uint64_t format;
+    std::uint64_t tape_layout;          /* TAPE_LAYOUT as written */
+    char          simdjson_version[16]; /* the tape's layout is simdjson's own */
+    std::uint64_t source_size;
+    std::uint64_t source_mtime; /* in nanoseconds, where the file system records them */
+    std::uint64_t path_size;
+    std::uint64_t tape_words;
+    std::uint64_t string_bytes;
+    std::uint64_t edges_hash;  /* of the tape's and the string buffer's edges */
+    std::uint64_t header_hash; /* of all of the above */
+
+    static constexpr char          MAGIC[16]   = "RcppSimdJsonTap";
+    static constexpr std::uint64_t ENDIAN_MARK = 0x0102030405060708;
+    static constexpr std::uint64_t FORMAT      = 3;
+    static constexpr std::uint64_t TAPE_LAYOUT = 1; /* see the static_asserts above */
+
+    [[nodiscard]] static auto padded(const std::uint64_t size) noexcept -> std::uint64_t {
+        return (size + 7) / 8 * 8;
+    }
+
+    [[nodiscard]] auto hash() const noexcept -> std::uint64_t {
+        return hash_string(std::string_view(reinterpret_cast<const char*>(this),
+                                            offsetof(Header, header_hash)));
+    }
+
+    [[nodiscard]] auto is_compatible() const noexcept -> bool {
+        char version[16] = {};
+        std::strncpy(version, SIMDJSON_VERSION, sizeof(version) - 1);
+        return std::memcmp(magic, MAGIC, sizeof(magic)) == 0 && byte_order == ENDIAN_MARK &&
+               format == FORMAT && tape_layout == TAPE_LAYOUT &&
+               std::memcmp(simdjson_version, version, sizeof(version)) == 0 &&
+               header_hash == hash();
+    }
+};
+
+
+inline auto hash_parts(const char*         tape,
+                       const std::uint64_t tape_words,
+                       const char*         strings,
+                       const std::uint64_t string_bytes) noexcept -> std::uint64_t {
+    return hash_edges(tape, tape_words * 8) ^
+           (hash_edges(strings, string_bytes) * 0x9E3779B97F4A7C15);
+}
+
+
+/**
+ * @brief The number of words of `document`'s tape, and of bytes used in its string buffer.
+ *
+ * The tape starts and ends with a root word, the first pointing past the last, and each string
+ * word points to a length-prefixed, NUL-terminated string (see simdjson's `dump_raw_tape()`).
+ */
+inline auto tape_extent(const simdjson::dom::document& document) noexcept
+    -> std::pair<std::uint64_t, std::uint64_t> {
+    constexpr auto VALUE_MASK = simdjson::internal::JSON_VALUE_MASK;
+
+    const auto* const tape    = document.tape.get();
+    const auto        n_words = tape[0] & VALUE_MASK;
+
+    auto string_bytes = std::uint64_t(0);
+    for (std::uint64_t i = 1; i + 1 < n_words; ++i) {
+        switch (static_cast<char>(tape[i] >> 56)) {
+            case '"': {
+                const auto   offset = tape[i] & VALUE_MASK;
+                std::uint32_t length;
+                std::memcpy(&length, document.string_buf.get() + offset, sizeof(length));
+                string_bytes = std::max(string_bytes, offset + sizeof(length) + length + 1);
+                break;
+            }
+            case 'l':
+            case 'u':
+            case 'd':
+                ++i; /* the number is the next word */
+                break;
+            default:
+                break;
+        }
+    }
+
+    return {n_words, string_bytes};
+}
+
+
+} // namespace tape_cache
+
+
+/**
+ * @brief While set in `Parse_Opts::tape_cache`, files parsed through the DOM (see `parse()`) have
+ * their tape and string buffer saved to a file in `directory`, and are later deserialized straight
+ * from that file instead of being parsed again, for as long as they haven't changed.
+ *
+ * Tape files are named after a hash of their source's path, and record its size and modification
+ * time (to the nanosecond where the file system keeps them), which must match for the tape to be
+ * used: like `make`, the cache trusts them rather than reading the source, so a rewrite that keeps
+ * both goes unnoticed. Since the tape's layout is simdjson's, tapes made by another simdjson
+ * version or tape layout (or on a machine of another byte order) are ignored, then replaced.
+ *
+ * Tapes are mapped into memory (or read, where mapping is unavailable) and are only valid while
+ * the cache is in scope; with Lazy_Strings, whose documents outlive it, they're copied instead.
+ * Saving is best effort: a tape that can't be written is just not cached.
+ */
+class Tape_Cache {
+    /**
+     * A document whose buffers are borrowed from a mapped tape file. The buffers are only pointed
+     * to once the Mapped_Tape is owned by `mapped_` (see `load()`), and nothing between that and
+     * the destructor can free them: whichever way the cache is destroyed, they're released before
+     * the document's `unique_ptr`s would `delete[]` them.
+     */
+    struct Mapped_Tape {
+        utils::Mapped_File      file;
+        simdjson::dom::document document;
+
+        Mapped_Tape() = default;
+        Mapped_Tape(const Mapped_Tape&) = delete;
+        Mapped_Tape& operator=(const Mapped_Tape&) = delete;
+        ~Mapped_Tape() {
+            static_cast<void>(document.tape.release());
+            static_cast<void>(document.string_buf.release());
+        }
+
+        void point(const char* tape, const char* strings) noexcept {
+            document.tape.reset(reinterpret_cast<std::uint64_t*>(const_cast<char*>(tape)));
+            document.string_buf.reset(
+                reinterpret_cast<std::uint8_t*>(const_cast<char*>(strings)));
+        }
+    };
+
+    using Document = simdjson::dom::document;
+
+    std::string                               directory_;
+    std::vector<std::unique_ptr<Mapped_Tape>> mapped_;
+    std::vector<std::unique_ptr<Document>>    read_; /* where mapping is unavailable */
+
+    struct Source {
+        std::uint64_t size;
+        std::uint64_t mtime;
+    };
+
+    static auto stat_source(const std::string& path) noexcept -> std::optional<Source> {
+#ifdef _WIN32
+        struct _stat64 info;
+        if (_stat64(path.c_str(), &info) != 0) {
+            return std::nullopt;
+        }
+#else
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return std::nullopt;
+        }
+#endif
+#if defined(__APPLE__)
+        const auto nanoseconds = static_cast<std::uint64_t>(info.st_mtimespec.tv_nsec);
+#elif defined(_WIN32)
+        const auto nanoseconds = std::uint64_t(0); /* seconds only */
+#else
+        const auto nanoseconds = static_cast<std::uint64_t>(info.st_mtim.tv_nsec);
+#endif
+        return Source{static_cast<std::uint64_t>(info.st_size),
+                      static_cast<std::uint64_t>(info.st_mtime) * 1000000000 + nanoseconds};
+    }
+
+    /* a name no other process or call writes to at the same time */
+    [[nodiscard]] static auto temp_suffix() -> std::string {
+        static auto counter = std::atomic<unsigned long long>(0);
+#ifdef _WIN32
+        const auto pid = static_cast<long long>(_getpid());
+#else
+        const auto pid = static_cast<long long>(getpid());
+#endif
+        return "." + std::to_string(pid) + "." + std::to_string(counter++) + ".tmp";
+    }
+
+    [[nodiscard]] auto tape_path(const std::string& path) const -> std::string {
+        char name[17];
+        std::snprintf(name,
+                      sizeof(name),
+                      "%016llx",
+                      static_cast<unsigned long long>(tape_cache::hash_string(path)));
+        return directory_ + "/" + name + ".tape";
+    }
+
+    /* `header` and the parts following it, if `data` holds a valid tape of `path` */
+    static auto check(const char*        data,
+                      const std::size_t  size,
+                      const std::string& path,
+                      const Source&      source) -> const tape_cache::Header* {
+        using tape_cache::Header;
+
+        if (size < sizeof(Header)) {
+            return nullptr;
+        }
+        const auto* header = reinterpret_cast<const Header*>(data);
+        if (!header->is_compatible() || header->source_size != source.size ||
+            header->source_mtime != source.mtime || header->path_size != std::size(path)) {
+            return nullptr;
+        }
+        /* sizes are checked against what's left, one part at a time, so that none can overflow */
+        auto left = std::uint64_t(size - sizeof(Header));
+        if (left < Header::padded(header->path_size) ||
+            std::memcmp(data + sizeof(Header), path.data(), std::size(path)) != 0) {
+            return nullptr;
+        }
+        left -= Header::padded(header->path_size);
+        if (header->tape_words < 2 || header->tape_words > left / 8) {
+            return nullptr;
+        }
+        left -= header->tape_words * 8;
+        if (header->string_bytes > left) {
+            return nullptr;
+        }
+
+        const auto* tape    = data + sizeof(Header) + Header::padded(header->path_size);
+        const auto* strings = tape + header->tape_words * 8;
+        if (tape_cache::hash_parts(tape, header->tape_words, strings, header->string_bytes) !=
+            header->edges_hash) {
+            return nullptr;
+        }
+        /* the root words must point at each other, as simdjson leaves them */
+        constexpr auto VALUE_MASK = simdjson::internal::JSON_VALUE_MASK;
+        std::uint64_t  first;
+        std::uint64_t  last;
+        std::memcpy(&first, tape, 8);
+        std::memcpy(&last, tape + (header->tape_words - 1) * 8, 8);
+        if (static_cast<char>(first >> 56) != 'r' || static_cast<char>(last >> 56) != 'r' ||
+            (first & VALUE_MASK) != header->tape_words || (last & VALUE_MASK) != 0) {
+            return nullptr;
+        }
+        return header;
+    }
+
+    static void copy(simdjson::dom::document& document,
+                     const tape_cache::Header& header,
+                     const char*               tape,
+                     const char*               strings) {
+        document.tape.reset(new std::uint64_t[header.tape_words]);
+        std::memcpy(document.tape.get(), tape, header.tape_words * 8);
+        document.string_buf.reset(new std::uint8_t[header.string_bytes + 1]);
+        std::memcpy(document.string_buf.get(), strings, header.string_bytes);
+    }
+
+  public:
+    explicit Tape_Cache(std::string directory) : directory_(std::move(directory)) {}
+
+    Tape_Cache(const Tape_Cache&) = delete;
+    Tape_Cache& operator=(const Tape_Cache&) = delete;
+
+    /**
+     * @brief The root of `path`'s cached tape, if it is up to date.
+     *
+     * @param owner Returns a document to copy the tape into, or `nullptr` for it to be mapped
+     * and borrowed for as long as the cache is in scope.
+     */
+    template <typename Owner>
+    auto load(const std::string& path, Owner&& owner) -> std::optional<simdjson::dom::element> {
+        using tape_cache::Header;
+
+        const auto source = stat_source(path);
+        if (!source) {
+            return std::nullopt;
+        }
+
+        auto       mapped    = std::make_unique<Mapped_Tape>();
+        auto       buffer    = std::string(); /* where mapping is unavailable */
+        const auto is_mapped = mapped->file.map(tape_path(path)) == simdjson::SUCCESS;
+        if (!is_mapped) {
+            auto* file = std::fopen(tape_path(path).c_str(), "rb");
+            if (!file) {
+                return std::nullopt;
+            }
+            char block[1 << 16];
+            while (const auto size = std::fread(block, 1, sizeof(block), file)) {
+                buffer.append(block, size);
+            }
+            std::fclose(file);
+        }
+        const auto* data = is_mapped ? mapped->file.data() : buffer.data();
+        const auto  size = is_mapped ? mapped->file.size() : std::size(buffer);
+
+        const auto* header = check(data, size, path, *source);
+        if (!header) {
+            return std::nullopt;
+        }
+        const auto* tape    = data + sizeof(Header) + Header::padded(header->path_size);
+        const auto* strings = tape + header->tape_words * 8;
+
+        if (auto* document = owner()) {
+            copy(*document, *header, tape, strings);
+            return document->root();
+        }
+        if (is_mapped) {
+            auto& owned = *mapped_.emplace_back(std::move(mapped));
+            owned.point(tape, strings);
+            return owned.document.root();
+        }
+        auto& document = *read_.emplace_back(std::make_unique<Document>());
+        copy(document, *header, tape, strings);
+        return document.root();
+    }
+
+    /**
+     * @brief Save the tape and string buffer `document` holds after parsing `path`.
+     */
+    void save(const std::string& path, const simdjson::dom::document& document) const {
+        using tape_cache::Header;
+
+        const auto source = stat_source(path);
+        if (!source) {
+            return;
+        }
+        const auto [tape_words, string_bytes] = tape_cache::tape_extent(document);
+        const auto* tape    = reinterpret_cast<const char*>(document.tape.get());
+        const auto* strings = reinterpret_cast<const char*>(document.string_buf.get());
+
+        auto header = Header{};
+        std::memcpy(header.magic, Header::MAGIC, sizeof(header.magic));
+        header.byte_order  = Header::ENDIAN_MARK;
+        header.format      = Header::FORMAT;
+        header.tape_layout = Header::TAPE_LAYOUT;
+        std::strncpy(
+            header.simdjson_version, SIMDJSON_VERSION, sizeof(header.simdjson_version) - 1);
+        header.source_size  = source->size;
+        header.source_mtime = source->mtime;
+        header.path_size    = std::size(path);
+        header.tape_words   = tape_words;
+        header.string_bytes = string_bytes;
+        header.edges_hash   = tape_cache::hash_parts(tape, tape_words, strings, string_bytes);
+        header.header_hash  = header.hash();
+
+        /* written aside, then renamed, so that no reader ever sees part of a tape */
+        const auto target = tape_path(path);
+        const auto temp   = target + temp_suffix();
+        auto*      file   = std::fopen(temp.c_str(), "wb");
+        if (!file) {
+            return;
+        }
+        const char padding[8] = {};
+        const auto n_padding  = Header::padded(header.path_size) - header.path_size;
+        const auto ok =
+            std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            std::fwrite(path.data(), 1, std::size(path), file) == std::size(path) &&
+            std::fwrite(padding, 1, n_padding, file) == n_padding &&
+            std::fwrite(tape, 8, tape_words, file) == tape_words &&
+            std::fwrite(strings, 1, string_bytes, file) == string_bytes;
+        if (std::fclose(file) != 0 || !ok) {
+            std::remove(temp.c_str());
+            return;
+        }
+#ifdef _WIN32
+        std::remove(target.c_str()); /* rename() doesn't replace files there */
+#endif
+        if (std::rename(temp.c_str(), target.c_str()) != 0) {
+            std::remove(temp.c_str());
+        }
+    }
+};
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -0,0 +1,544 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__ARROW_HPP
+#define RCPPSIMDJSON__DESERIALIZE__ARROW_HPP
+
+
+#include "../common.hpp"
+
+#include <cstdint>       /* int64_t, uint8_t */
+#include <limits>        /* std::numeric_limits */
+#include <memory>        /* std::unique_ptr */
+#include <string>        /* std::string */
+#include <string_view>   /* std::string_view */
+#include <unordered_map> /* std::unordered_map */
+#include <utility>       /* std::move, std::pair */
+#include <vector>        /* std::vector */
+
+
+/*
+ * The Arrow C Data Interface, as specified (and to be copied verbatim) by
+ * https://arrow.apache.org/docs/format/CDataInterface.html , so that no Arrow library is needed.
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#    define ARROW_C_DATA_INTERFACE
+
+#    define ARROW_FLAG_DICTIONARY_ORDERED 1
+#    define ARROW_FLAG_NULLABLE 2
+#    define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char*          format;
+    const char*          name;
+    const char*          metadata;
+    int64_t              flags;
+    int64_t              n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema*  dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t             length;
+    int64_t             null_count;
+    int64_t             offset;
+    int64_t             n_buffers;
+    int64_t             n_children;
+    const void**        buffers;
+    struct ArrowArray** children;
+    struct ArrowArray*  dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+namespace arrow {
+
+
+/**
+ * @brief Arrow types that JSON values are built into.
+ */
+enum class Layout {
+    null,    /* only `null`s */
+    boolean, /* `true`/`false` */
+    int64,   /* integers */
+    float64, /* numbers, with at least one double (or integer beyond int64) */
+    utf8,    /* strings */
+    text,    /* mixed types: strings as they are, anything else as minified JSON */
+    list,    /* arrays, of their elements' common type */
+    struct_, /* objects, with a child per key */
+};
+
+
+/* `Column::kinds_` bits */
+inline constexpr unsigned NULL_KIND   = 1U << 0U;
+inline constexpr unsigned BOOL_KIND   = 1U << 1U;
+inline constexpr unsigned INT_KIND    = 1U << 2U;
+inline constexpr unsigned NUMBER_KIND = 1U << 3U; /* doubles and uint64s beyond int64 */
+inline constexpr unsigned STRING_KIND = 1U << 4U;
+inline constexpr unsigned ARRAY_KIND  = 1U << 5U;
+inline constexpr unsigned OBJECT_KIND = 1U << 6U;
+
+
+inline void set_bit(std::vector<uint8_t>& bits, const int64_t i, const bool value) {
+    const auto byte = static_cast<std::size_t>(i / 8);
+    if (byte >= std::size(bits)) {
+        bits.resize(byte + 1, 0);
+    }
+    if (value) {
+        bits[byte] |= static_cast<uint8_t>(1U << (i % 8));
+    } else {
+        bits[byte] &= static_cast<uint8_t>(~(1U << (i % 8)));
+    }
+}
+
+
+/**
+ * @brief What the release callbacks free: the exported buffers and children.
+ */
+struct Exported_Schema {
+    std::string               format;
+    std::string               name;
+    std::vector<ArrowSchema*> children;
+};
+
+struct Exported_Array {
+    std::vector<uint8_t>      validity;
+    std::vector<uint8_t>      bits;
+    std::vector<int64_t>      int64s;
+    std::vector<double>       doubles;
+    std::vector<int32_t>      offsets32;
+    std::vector<int64_t>      offsets64;
+    std::string               chars;
+    std::vector<const void*>  buffers;
+    std::vector<ArrowArray*>  children;
+};
+
+
+inline void release_schema(ArrowSchema* schema) {
+    auto* exported = static_cast<Exported_Schema*>(schema->private_data);
+    for (auto* child : exported->children) {
+        if (child->release) {
+            child->release(child);
+        }
+        delete child;
+    }
+    delete exported;
+    schema->release = nullptr;
+}
+
+inline void release_array(ArrowArray* array) {
+    auto* exported = static_cast<Exported_Array*>(array->private_data);
+    for (auto* child : exported->children) {
+        if (child->release) {
+            child->release(child);
+        }
+        delete child;
+    }
+    delete exported;
+    array->release = nullptr;
+}
+
+
+/**
+ * @brief An Arrow array built straight from simdjson elements, in two passes.
+ *
+ * `infer()` sees every value first, so that `resolve()` can pick a single Layout for the column
+ * (recursively for list elements and struct fields). `append()` then writes each value to the
+ * column's buffers, which `export_to()` hands over to an ArrowSchema/ArrowArray pair without
+ * copying them.
+ *
+ * Struct fields are in order of first appearance, and missing fields are `null`. Keys are views
+ * into the simdjson document, so a Column must not outlive it.
+ */
+class Column {
+    unsigned kinds_  = 0;
+    Layout   layout_ = Layout::null;
+
+    int64_t              length_     = 0;
+    int64_t              null_count_ = 0;
+    std::vector<uint8_t> validity_; /* empty until the first `null` */
+    std::vector<uint8_t> bits_;
+    std::vector<int64_t> int64s_;
+    std::vector<double>  doubles_;
+    std::vector<int64_t> offsets_; /* narrowed to int32 when exported, if they fit */
+    std::string          chars_;
+
+    std::unique_ptr<Column>                                          items_;
+    std::vector<std::pair<std::string_view, std::unique_ptr<Column>>> fields_;
+    std::unordered_map<std::string_view, std::size_t>                 field_index_;
+    std::vector<int64_t>                                              field_rows_;
+
+    auto field(const std::string_view key) -> std::size_t {
+        if (const auto it = field_index_.find(key); it != std::end(field_index_)) {
+            return it->second;
+        }
+        fields_.emplace_back(key, std::make_unique<Column>());
+        return field_index_[key] = std::size(fields_) - 1;
+    }
+
+    void push_validity(const bool is_valid) {
+        if (!is_valid && null_count_++ == 0) {
+            for (int64_t i = 0; i < length_; ++i) {
+                set_bit(validity_, i, true);
+            }
+        }
+        if (null_count_ > 0) {
+            set_bit(validity_, length_, is_valid);
+        }
+    }
+
+  public:
+    /** @brief First pass: record the kind of `element` (and of its elements or fields). */
+    void infer(simdjson::dom::element element) {
+        switch (element.type()) {
+            case simdjson::dom::element_type::NULL_VALUE:
+                kinds_ |= NULL_KIND;
+                break;
+            case simdjson::dom::element_type::BOOL:
+                kinds_ |= BOOL_KIND;
+                break;
+            case simdjson::dom::element_type::INT64:
+                kinds_ |= INT_KIND;
+                break;
+            case simdjson::dom::element_type::UINT64:
+            case simdjson::dom::element_type::DOUBLE:
+                kinds_ |= NUMBER_KIND;
+                break;
+            case simdjson::dom::element_type::STRING:
+                kinds_ |= STRING_KIND;
+                break;
+            case simdjson::dom::element_type::ARRAY: {
+                kinds_ |= ARRAY_KIND;
+                if (!items_) {
+                    items_ = std::make_unique<Column>();
+                }
+                for (auto item : simdjson::dom::array(element)) {
+                    items_->infer(item);
+                }
+                break;
+            }
+            case simdjson::dom::element_type::OBJECT: {
+                kinds_ |= OBJECT_KIND;
+                for (auto [key, value] : simdjson::dom::object(element)) {
+                    fields_[field(key)].second->infer(value);
+                }
+                break;
+            }
+        }
+    }
+
+    /** @brief Pick the Layout of the column (and its children) from what `infer()` saw. */
+    void resolve() {
+        switch (kinds_ & ~NULL_KIND) {
+            case 0:
+                layout_ = Layout::null;
+                break;
+            case BOOL_KIND:
+                layout_ = Layout::boolean;
+                break;
+            case INT_KIND:
+                layout_ = Layout::int64;
+                break;
+            case NUMBER_KIND:
+            case INT_KIND | NUMBER_KIND:
+                layout_ = Layout::float64;
+                break;
+            case STRING_KIND:
+                layout_ = Layout::utf8;
+                break;
+            case ARRAY_KIND:
+                layout_ = Layout::list;
+                items_->resolve();
+                break;
+            case OBJECT_KIND:
+                layout_ = Layout::struct_;
+                for (auto& [key, child] : fields_) {
+                    child->resolve();
+                }
+                field_rows_.assign(std::size(fields_), -1);
+                break;
+            default:
+                layout_ = Layout::text;
+        }
+
+        if (layout_ != Layout::list) {
+            items_.reset();
+        }
+        if (layout_ != Layout::struct_) {
+            fields_.clear();
+            field_index_.clear();
+        }
+        if (layout_ == Layout::utf8 || layout_ == Layout::text || layout_ == Layout::list) {
+            offsets_.push_back(0);
+        }
+    }
+
+    /** @brief Second pass: write `element` to the column's buffers. */
+    void append(simdjson::dom::element element) {
+        if (element.is_null()) {
+            append_null();
+            return;
+        }
+
+        switch (layout_) {
+            case Layout::null: /* unreachable: `null`s are handled above */
+                append_null();
+                return;
+            case Layout::boolean:
+                set_bit(bits_, length_, bool(element));
+                break;
+            case Layout::int64:
+                int64s_.push_back(int64_t(element));
+                break;
+            case Layout::float64:
+                doubles_.push_back(double(element));
+                break;
+            case Layout::utf8:
+                chars_.append(std::string_view(element));
+                offsets_.push_back(static_cast<int64_t>(std::size(chars_)));
+                break;
+            case Layout::text:
+                if (element.is_string()) {
+                    chars_.append(std::string_view(element));
+                } else {
+                    chars_.append(simdjson::minify(element));
+                }
+                offsets_.push_back(static_cast<int64_t>(std::size(chars_)));
+                break;
+            case Layout::list:
+                for (auto item : simdjson::dom::array(element)) {
+                    items_->append(item);
+                }
+                offsets_.push_back(items_->length_);
+                break;
+            case Layout::struct_: {
+                for (auto [key, value] : simdjson::dom::object(element)) {
+                    const auto i_field = field_index_.at(key);
+                    if (field_rows_[i_field] != length_) { /* the first of duplicate keys wins */
+                        field_rows_[i_field] = length_;
+                        fields_[i_field].second->append(value);
+                    }
+                }
+                for (std::size_t i_field = 0; i_field < std::size(fields_); ++i_field) {
+                    if (field_rows_[i_field] != length_) {
+                        fields_[i_field].second->append_null();
+                    }
+                }
+                break;
+            }
+        }
+
+        push_validity(true);
+        ++length_;
+    }
+
+    void append_null() {
+        switch (layout_) {
+            case Layout::null:
+                ++null_count_;
+                ++length_;
+                return;
+            case Layout::boolean:
+                set_bit(bits_, length_, false);
+                break;
+            case Layout::int64:
+                int64s_.push_back(0);
+                break;
+            case Layout::float64:
+                doubles_.push_back(0);
+                break;
+            case Layout::utf8:
+            case Layout::text:
+            case Layout::list:
+                offsets_.push_back(offsets_.back());
+                break;
+            case Layout::struct_:
+                for (auto& [key, child] : fields_) {
+                    child->append_null();
+                }
+                break;
+        }
+
+        push_validity(false);
+        ++length_;
+    }
+
+    /**
+     * @brief Move the column's buffers into `schema` and `array`, which must be released by their
+     * consumer (see the C Data Interface's release callbacks).
+     */
+    void export_to(ArrowSchema* schema, ArrowArray* array, const std::string_view name) {
+        auto exported_schema  = std::make_unique<Exported_Schema>();
+        auto exported_array   = std::make_unique<Exported_Array>();
+        exported_schema->name = std::string(name);
+
+        const auto  validity = null_count_ > 0 && layout_ != Layout::null;
+        auto&       buffers  = exported_array->buffers;
+        const auto  n_bytes  = static_cast<std::size_t>((length_ + 7) / 8);
+        if (validity) {
+            validity_.resize(n_bytes, 0);
+            exported_array->validity = std::move(validity_);
+        }
+        const void* validity_buffer = validity ? exported_array->validity.data() : nullptr;
+
+        /* offsets fit in int32 unless there are more than 2^31 - 1 bytes or list elements */
+        const auto is_large = !offsets_.empty() &&
+                              offsets_.back() > std::numeric_limits<int32_t>::max();
+        const auto export_offsets = [&]() -> const void* {
+            if (is_large) {
+                exported_array->offsets64 = std::move(offsets_);
+                return exported_array->offsets64.data();
+            }
+            exported_array->offsets32.assign(std::begin(offsets_), std::end(offsets_));
+            return exported_array->offsets32.data();
+        };
+
+        switch (layout_) {
+            case Layout::null:
+                exported_schema->format = "n";
+                break;
+            case Layout::boolean:
+                exported_schema->format = "b";
+                bits_.resize(n_bytes, 0);
+                bits_.reserve(1); /* consumers expect non-null value buffers */
+                exported_array->bits = std::move(bits_);
+                buffers = {validity_buffer, exported_array->bits.data()};
+                break;
+            case Layout::int64:
+                exported_schema->format = "l";
+                int64s_.reserve(1);
+                exported_array->int64s = std::move(int64s_);
+                buffers = {validity_buffer, exported_array->int64s.data()};
+                break;
+            case Layout::float64:
+                exported_schema->format = "g";
+                doubles_.reserve(1);
+                exported_array->doubles = std::move(doubles_);
+                buffers = {validity_buffer, exported_array->doubles.data()};
+                break;
+            case Layout::utf8:
+            case Layout::text: {
+                exported_schema->format = is_large ? "U" : "u";
+                const auto offsets      = export_offsets();
+                exported_array->chars   = std::move(chars_);
+                buffers = {validity_buffer, offsets, exported_array->chars.data()};
+                break;
+            }
+            case Layout::list: {
+                exported_schema->format = is_large ? "+L" : "+l";
+                buffers                 = {validity_buffer, export_offsets()};
+                exported_schema->children.push_back(new ArrowSchema());
+                exported_array->children.push_back(new ArrowArray());
+                items_->export_to(
+                    exported_schema->children.back(), exported_array->children.back(), "item");
+                break;
+            }
+            case Layout::struct_:
+                exported_schema->format = "+s";
+                buffers                 = {validity_buffer};
+                for (auto& [key, child] : fields_) {
+                    exported_schema->children.push_back(new ArrowSchema());
+                    exported_array->children.push_back(new ArrowArray());
+                    child->export_to(
+                        exported_schema->children.back(), exported_array->children.back(), key);
+                }
+                break;
+        }
+
+        *schema = ArrowSchema{exported_schema->format.c_str(),
+                              exported_schema->name.c_str(),
+                              nullptr,
+                              ARROW_FLAG_NULLABLE,
+                              static_cast<int64_t>(std::size(exported_schema->children)),
+                              exported_schema->children.data(),
+                              nullptr,
+                              release_schema,
+                              exported_schema.release()};
+
+        *array = ArrowArray{length_,
+                            null_count_,
+                            0,
+                            static_cast<int64_t>(std::size(buffers)),
+                            static_cast<int64_t>(std::size(exported_array->children)),
+                            buffers.data(),
+                            exported_array->children.data(),
+                            nullptr,
+                            release_array,
+                            exported_array.release()};
+    }
+};
+
+
+inline void finalize_schema(ArrowSchema* schema) {
+    if (schema->release) {
+        schema->release(schema);
+    }
+    delete schema;
+}
+
+inline void finalize_array(ArrowArray* array) {
+    if (array->release) {
+        array->release(array);
+    }
+    delete array;
+}
+
+
+/**
+ * @brief Build `element` into an Arrow array: an array of objects becomes a struct array with a
+ * child per key (i.e. a record batch), any other array an array of its elements' common type, and
+ * anything else an array of length 1.
+ *
+ * @return An external pointer to the ArrowArray, holding one to its ArrowSchema as its tag. Their
+ * classes, `"nanoarrow_array"` and `"nanoarrow_schema"`, follow the nanoarrow package's layout, so
+ * it (and arrow, duckdb, ... through it) can take them over without copying any buffer.
+ */
+inline auto build_arrow(simdjson::dom::element element) -> SEXP {
+    auto column = Column();
+    if (element.is_array()) {
+        const auto array = simdjson::dom::array(element);
+        for (auto item : array) {
+            column.infer(item);
+        }
+        column.resolve();
+        for (auto item : array) {
+            column.append(item);
+        }
+    } else {
+        column.infer(element);
+        column.resolve();
+        column.append(element);
+    }
+
+    auto schema = Rcpp::XPtr<ArrowSchema, Rcpp::PreserveStorage, finalize_schema>(
+        new ArrowSchema{nullptr, nullptr, nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr});
+    auto array = Rcpp::XPtr<ArrowArray, Rcpp::PreserveStorage, finalize_array>(
+        new ArrowArray{0, 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr},
+        true,
+        schema);
+    column.export_to(schema.get(), array.get(), "");
+
+    schema.attr("class") = "nanoarrow_schema";
+    array.attr("class")  = "nanoarrow_array";
+    return array;
+}
+
+
+} // namespace arrow
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -5,6 +5,13 @@
 #include "RcppSimdJson/utils.hpp"
 #include "matrix.hpp"
 
+#include <algorithm>
+#include <memory>
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif
+
 
 namespace rcppsimdjson {
 namespace deserialize {
@@ -51,190 +58,446 @@ inline auto diagnose_data_frame(simdjson::dom::array array) noexcept(RCPPSIMDJSO
 }
 
 
-template <int RTYPE,
-          typename scalar_T,
-          rcpp_T              R_Type,
-          Type_Policy         type_policy,
-          utils::Int64_R_Type int64_opt>
-inline auto build_col(simdjson::dom::array                       array,
-                      const std::string_view                     key,
-                      const Type_Doctor<type_policy, int64_opt>& type_doc) -> Rcpp::Vector<RTYPE> {
-
-    auto out   = Rcpp::Vector<RTYPE>(std::size(array), na_val<R_Type>());
-    auto i_row = R_xlen_t(0L);
-
-    if (type_doc.is_homogeneous()) {
-        if (type_doc.has_null()) {
-            for (auto object : array) {
-                simdjson::dom::element element;
-                if(object.get_object().at_key(key).get(element) == simdjson::SUCCESS) {
-                    out[i_row] = get_scalar<scalar_T, R_Type, HAS_NULLS>(element);
-                }
-                i_row++;
-            }
+/**
+ * @brief A data frame column being filled, row by row, by `build_data_frame()`.
+ *
+ * `values` is preallocated and filled with the column's `NA`. `data` points to the cells of
+ * `values` (or `integer64`) for every type but strings and lists, so those cells can be written
+ * without touching the R API.
+ *
+ * With a `Parse_Opts::lazy_strings`, homogeneous `chr` columns are `is_lazy`: `values` is left
+ * empty and `data` points to `strings`, which `finish_lazy_col()` turns into a lazy character
+ * vector.
+ *
+ * With `Parse_Opts::max_factor_levels` above 0, homogeneous `chr` columns have a `factor`
+ * instead: `values` holds the codes it assigns, which `finish_factor_col()` turns into a factor.
+ */
+struct Column_Slot {
+    Rcpp::RObject                   values         = Rcpp::RObject();
+    rcpp_T                          R_type         = rcpp_T::null;
+    bool                            is_homogeneous = true;
+    std::vector<int64_t>            integer64      = std::vector<int64_t>(); // integer64 only
+    void*                           data           = nullptr;
+    bool                            is_lazy        = false;
+    std::vector<std::string_view>   strings        = std::vector<std::string_view>(); // lazy only
+    std::unique_ptr<Factor_Builder> factor         = nullptr;
+};
 
-        } else {
 
-            for (auto object : array) {
-                simdjson::dom::element element;
-                if(object.get_object().at_key(key).get(element) == simdjson::SUCCESS) {
-                    out[i_row] = get_scalar<scalar_T, R_Type, NO_NULLS>(element);
-                }
-                i_row++;
-            }
-        }
+/**
+ * @brief Whether cells of `R_type` are set without the R API (see `Column_Slot`), so that worker
+ * threads can fill them.
+ */
+template <utils::Int64_R_Type int64_opt>
+inline constexpr bool is_thread_safe(const rcpp_T R_type) noexcept {
+    switch (R_type) {
+        case rcpp_T::dbl:
+        case rcpp_T::i32:
+        case rcpp_T::lgl:
+        case rcpp_T::null:
+            return true;
+        case rcpp_T::i64:
+            return int64_opt != utils::Int64_R_Type::String;
+        default:
+            return false;
+    }
+}
 
-    } else {
 
-        for (auto object : array) {
-            simdjson::dom::element element;
-            if(object.get_object().at_key(key).get(element) == simdjson::SUCCESS) {
-                out[i_row] = get_scalar_dispatch<RTYPE>(element);
+template <int RTYPE, typename scalar_T, rcpp_T R_Type>
+inline void set_cell(const Column_Slot&     slot,
+                     const R_xlen_t         i_row,
+                     simdjson::dom::element element,
+                     String_Cache* const    string_cache = nullptr) {
+    if constexpr (RTYPE == STRSXP) {
+        if constexpr (std::is_same_v<scalar_T, std::string>) {
+            if (slot.factor) {
+                if (element.is_string()) {
+                    static_cast<int*>(slot.data)[i_row] =
+                        slot.factor->code(std::string_view(element));
+                }
+                return;
             }
-            i_row++;
+            if (slot.is_lazy) {
+                if (element.is_string()) {
+                    static_cast<std::string_view*>(slot.data)[i_row] =
+                        Lazy_Strings::view(std::string_view(element));
+                }
+                return;
+            }
+        }
+        if (!slot.is_homogeneous) {
+            SET_STRING_ELT(slot.values,
+                           i_row,
+                           get_scalar_dispatch<STRSXP>(element, string_cache).get_sexp());
+        } else if constexpr (std::is_same_v<scalar_T, std::string>) {
+            /* a CHARSXP, see `make_charsxp()` */
+            SET_STRING_ELT(
+                slot.values, i_row, get_scalar<scalar_T, R_Type, HAS_NULLS>(element, string_cache));
+        } else {
+            SET_STRING_ELT(
+                slot.values, i_row, get_scalar<scalar_T, R_Type, HAS_NULLS>(element).get_sexp());
         }
     }
 
-    return out;
-}
+    if constexpr (RTYPE == REALSXP) {
+        static_cast<double*>(slot.data)[i_row] =
+            slot.is_homogeneous ? get_scalar<scalar_T, R_Type, HAS_NULLS>(element)
+                                : get_scalar_dispatch<REALSXP>(element);
+    }
 
+    if constexpr (RTYPE == INTSXP || RTYPE == LGLSXP) {
+        static_cast<int*>(slot.data)[i_row] = slot.is_homogeneous
+                                                  ? get_scalar<scalar_T, R_Type, HAS_NULLS>(element)
+                                                  : get_scalar_dispatch<RTYPE>(element);
+    }
+}
 
-template <Type_Policy type_policy, utils::Int64_R_Type int64_opt>
-inline auto build_col_integer64(simdjson::dom::array                      array,
-                                const std::string_view                    key,
-                                const Type_Doctor<type_policy, int64_opt> type_doc) -> SEXP {
 
+template <utils::Int64_R_Type int64_opt>
+inline void set_cell_integer64(const Column_Slot&     slot,
+                               const R_xlen_t         i_row,
+                               simdjson::dom::element element) {
     if constexpr (int64_opt == utils::Int64_R_Type::Double) {
-        return build_col<REALSXP, int64_t, rcpp_T::dbl, type_policy>(array, key, type_doc);
+        set_cell<REALSXP, int64_t, rcpp_T::dbl>(slot, i_row, element);
     }
 
     if constexpr (int64_opt == utils::Int64_R_Type::String) {
-        return build_col<STRSXP, int64_t, rcpp_T::chr, type_policy>(array, key, type_doc);
+        set_cell<STRSXP, int64_t, rcpp_T::chr>(slot, i_row, element);
     }
 
     if constexpr (int64_opt == utils::Int64_R_Type::Integer64 ||
                   int64_opt == utils::Int64_R_Type::Always) {
-        auto stl_vec = std::vector<int64_t>(std::size(array), NA_INTEGER64);
-        auto i_row   = std::size_t(0ULL);
-
-        if (type_doc.is_homogeneous()) {
-            if (type_doc.has_null()) {
-                for (auto object : array) {
-                    simdjson::dom::element element;
-                    if(object.get_object().at_key(key).get(element) == simdjson::SUCCESS) {
-                        stl_vec[i_row] = get_scalar<int64_t, rcpp_T::i64, HAS_NULLS>(element);
-                    }
-                    i_row++;
-                }
+        const auto integer64 = static_cast<int64_t*>(slot.data);
+        if (slot.is_homogeneous) {
+            integer64[i_row] = get_scalar<int64_t, rcpp_T::i64, HAS_NULLS>(element);
+            return;
+        }
 
-            } else {
-                for (auto object : array) {
-                    simdjson::dom::element element;
-                    if(object.get_object().at_key(key).get(element) == simdjson::SUCCESS) {
-                        stl_vec[i_row] = get_scalar<int64_t, rcpp_T::i64, NO_NULLS>(element);
-                    }
-                    i_row++;
-                }
+        switch (element.type()) {
+            case simdjson::dom::element_type::INT64:
+                integer64[i_row] = get_scalar<int64_t, rcpp_T::i64, NO_NULLS>(element);
+                break;
+
+            case simdjson::dom::element_type::BOOL:
+                integer64[i_row] = get_scalar<bool, rcpp_T::i64, NO_NULLS>(element);
+                break;
+
+            default:							// #nocov
+                break;							// #nocov
+        }
+    }
+}
+
+
+/**
+ * @brief A column of `n_rows` `NA`s, of the type `type_doc` found.
+ *
+ * @param na_cell The `NA_integer_` shared by the missing cells of list columns.
+ */
+template <Type_Policy type_policy, utils::Int64_R_Type int64_opt>
+inline auto allocate_col(const Type_Doctor<type_policy, int64_opt>& type_doc,
+                         const R_xlen_t                             n_rows,
+                         SEXP                                       na_cell,
+                         const Parse_Opts&                          parse_opts) -> Column_Slot {
+    auto slot = Column_Slot{Rcpp::RObject(), type_doc.common_R_type(), type_doc.is_homogeneous()};
+
+    switch (slot.R_type) {
+        case rcpp_T::chr:
+            if (slot.is_homogeneous && parse_opts.max_factor_levels > 0) {
+                slot.values = Rcpp::IntegerVector(n_rows, NA_INTEGER);
+                slot.data   = INTEGER(slot.values);
+                slot.factor = std::make_unique<Factor_Builder>(parse_opts);
+                break;
+            }
+            if (slot.is_homogeneous && parse_opts.lazy_strings) {
+                slot.is_lazy = true;
+                slot.strings = std::vector<std::string_view>(n_rows);
+                slot.data    = slot.strings.data();
+                break;
+            }
+            slot.values = Rcpp::CharacterVector(n_rows, NA_STRING);
+            break;
+
+        case rcpp_T::u64:
+            slot.values = Rcpp::CharacterVector(n_rows, NA_STRING);
+            break;
+
+        case rcpp_T::dbl:
+            slot.values = Rcpp::NumericVector(n_rows, NA_REAL);
+            slot.data   = REAL(slot.values);
+            break;
+
+        case rcpp_T::i64: {
+            if constexpr (int64_opt == utils::Int64_R_Type::Double) {
+                slot.values = Rcpp::NumericVector(n_rows, NA_REAL);
+                slot.data   = REAL(slot.values);
+            }
+            if constexpr (int64_opt == utils::Int64_R_Type::String) {
+                slot.values = Rcpp::CharacterVector(n_rows, NA_STRING);
             }
+            if constexpr (int64_opt == utils::Int64_R_Type::Integer64 ||
+                          int64_opt == utils::Int64_R_Type::Always) {
+                slot.integer64 = std::vector<int64_t>(n_rows, NA_INTEGER64);
+                slot.data      = slot.integer64.data();
+            }
+            break;
+        }
 
-        } else {
-            for (auto object : array) {
-                simdjson::dom::element element;
-                if(object.get_object().at_key(key).get(element) == simdjson::SUCCESS) {
-                    switch (element.type()) {
-                        case simdjson::dom::element_type::INT64:
-                            stl_vec[i_row] = get_scalar<int64_t, rcpp_T::i64, NO_NULLS>(element);
-                            break;
-
-                        case simdjson::dom::element_type::BOOL:
-                            stl_vec[i_row] = get_scalar<bool, rcpp_T::i64, NO_NULLS>(element);
-                            break;
-
-                        default:					// #nocov
-                            break;					// #nocov
-                    }
-                }
-                i_row++;
+        case rcpp_T::i32:
+            slot.values = Rcpp::IntegerVector(n_rows, NA_INTEGER);
+            slot.data   = INTEGER(slot.values);
+            break;
+
+        case rcpp_T::lgl:
+        case rcpp_T::null:
+            slot.values = Rcpp::LogicalVector(n_rows, NA_LOGICAL);
+            slot.data   = LOGICAL(slot.values);
+            break;
+
+        default: {
+            /* missing fields of list columns are all the same `NA` */
+            auto this_col = Rcpp::List(n_rows);
+            for (R_xlen_t i_row = 0; i_row < n_rows; ++i_row) {
+                SET_VECTOR_ELT(this_col, i_row, na_cell);
             }
+            slot.values = this_col;
         }
-        return utils::as_integer64(stl_vec);
     }
+
+    return slot;
 }
 
 
+/**
+ * @brief The factor (or character vector, if it has too many levels) of a slot with a `factor`,
+ * once it has been filled.
+ */
+inline auto finish_factor_col(Column_Slot& slot) -> SEXP {
+    slot.data = nullptr;
+    return slot.factor->finish(Rcpp::IntegerVector(static_cast<SEXP>(slot.values)));
+}
+
+
+/**
+ * @brief The lazy character vector of an `is_lazy` slot, once it has been filled.
+ */
+inline auto finish_lazy_col(Column_Slot& slot, const Lazy_Strings& lazy) -> SEXP {
+    slot.data = nullptr;
+    return make_lazy_strings(std::move(slot.strings), lazy);
+}
+
+
+/**
+ * @brief The column found at each field position of the previous record.
+ *
+ * Records usually share their layout, so each key is first compared with the one at the same
+ * position in the previous record, and only looked up when they differ. Keys are views into the
+ * document, so a Key_Cache must not outlive it.
+ */
+class Key_Cache {
+    std::vector<std::pair<std::string_view, R_xlen_t>> cols_;
+
+  public:
+    explicit Key_Cache(const R_xlen_t n_cols) { cols_.reserve(n_cols); }
+
+    /**
+     * @brief Call `fun(i_col, value)` for each field of `record`, where `i_col` is what
+     * `find_col(key)` returns for its key.
+     */
+    template <typename find_T, typename fun_T>
+    void for_each_field(simdjson::dom::object record, const find_T& find_col, const fun_T& fun) {
+        auto i_field = std::size_t(0ULL);
+        for (auto [key, value] : record) {
+            if (i_field == std::size(cols_)) {
+                cols_.emplace_back(key, find_col(key));
+            } else if (cols_[i_field].first != key) {
+                cols_[i_field] = {key, find_col(key)};
+            }
+            fun(cols_[i_field++].second, value);
+        }
+    }
+};
+
+
+/**
+ * @brief Store `value` in row `i_row` of `slot`, according to the column's R type.
+ */
+template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
+inline void set_slot(const Column_Slot&     slot,
+                     const R_xlen_t         i_row,
+                     simdjson::dom::element value,
+                     const Parse_Opts&      parse_opts) {
+    switch (slot.R_type) {
+        case rcpp_T::chr:
+            set_cell<STRSXP, std::string, rcpp_T::chr>(slot, i_row, value, parse_opts.string_cache);
+            break;
+
+        case rcpp_T::dbl:
+            set_cell<REALSXP, double, rcpp_T::dbl>(slot, i_row, value);
+            break;
+
+        case rcpp_T::i64:
+            set_cell_integer64<int64_opt>(slot, i_row, value);
+            break;
+
+        case rcpp_T::i32:
+            set_cell<INTSXP, int64_t, rcpp_T::i32>(slot, i_row, value);
+            break;
+
+        case rcpp_T::lgl:
+            set_cell<LGLSXP, bool, rcpp_T::lgl>(slot, i_row, value);
+            break;
+
+        case rcpp_T::null:
+            break;
+
+        case rcpp_T::u64:
+            set_cell<STRSXP, uint64_t, rcpp_T::chr>(slot, i_row, value, parse_opts.string_cache);
+            break;
+
+        default:
+            SET_VECTOR_ELT(
+                slot.values,
+                i_row,
+                simplify_element<type_policy, int64_opt, simplify_to>(value, parse_opts));
+    }
+}
+
+
+/**
+ * @brief Build a data frame from an array of objects in a single, row-major pass.
+ *
+ * Every column is preallocated from its schema (see `diagnose_data_frame()`), then each object is
+ * walked once and each of its fields is routed to its column's slot. Records typically share the
+ * same key order, so the key found at the same position of the previous object is checked before
+ * falling back to the schema's hash map.
+ *
+ * When `parse_opts.threads` is above 1, the rows are split into blocks and worker threads fill
+ * the `is_thread_safe()` columns of their blocks, then the calling thread fills the string and
+ * list columns (if any) in a second pass.
+ */
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
 inline auto
 build_data_frame(simdjson::dom::array                                                        array,
                  const std::unordered_map<std::string_view, Column<type_policy, int64_opt>>& cols,
-                 SEXP empty_array,
-                 SEXP empty_object,
-                 SEXP single_null) -> SEXP {
+                 const Parse_Opts& parse_opts) -> SEXP {
 
     const auto n_rows    = R_xlen_t(std::size(array));
-    auto       out       = Rcpp::List(std::size(cols));
-    auto       out_names = Rcpp::CharacterVector(std::size(cols));
+    const auto n_cols    = R_xlen_t(std::size(cols));
+    auto       out       = Rcpp::List(n_cols);
+    auto       out_names = Rcpp::CharacterVector(n_cols);
+    const auto na_cell   = Rcpp::IntegerVector(1, NA_INTEGER);
 
+    auto slots = std::vector<Column_Slot>(n_cols);
     for (auto&& [key, col] : cols) {
-        out_names[col.index] = Rcpp::String(std::string(key));
+        out_names[col.index] = make_charsxp(key, parse_opts.string_cache);
+        slots[col.index] =
+            allocate_col<type_policy, int64_opt>(col.schema, n_rows, na_cell, parse_opts);
+        out[col.index]       = slots[col.index].values;
+    }
 
-        switch (col.schema.common_R_type()) {
-            case rcpp_T::chr: {
-                out[col.index] = build_col<STRSXP, std::string, rcpp_T::chr, type_policy>(
-                    array, key, col.schema);
-                break;
-            }
+    /* columns filled by worker threads, if any */
+    auto in_worker = std::vector<bool>(n_cols, false);
+    auto n_threads = 1;
+#ifdef _OPENMP
+    if (parse_opts.threads > 1 && n_rows > 1) {
+        for (R_xlen_t i_col = 0; i_col < n_cols; ++i_col) {
+            /* `null` columns are already complete */
+            in_worker[i_col] = slots[i_col].R_type != rcpp_T::null &&
+                               is_thread_safe<int64_opt>(slots[i_col].R_type);
+        }
+        if (std::find(std::begin(in_worker), std::end(in_worker), true) != std::end(in_worker)) {
+            n_threads = static_cast<int>(std::min<R_xlen_t>(parse_opts.threads, n_rows));
+        }
+    }
+#endif
 
-            case rcpp_T::dbl: {
-                out[col.index] =
-                    build_col<REALSXP, double, rcpp_T::dbl, type_policy>(array, key, col.schema);
-                break;
+    const auto find_col = [&cols](const std::string_view key) {
+        return cols.find(key)->second.index;
+    };
+
+    /* Route each field of `object` to its column's slot if `in_worker` matches `worker`. Like
+     * `at_key()`, only the first occurrence of a duplicate key is kept. `last_row` holds the last
+     * row set in each column: every thread needs its own, as well as its own `key_cache`. */
+    const auto fill_row = [&](simdjson::dom::object  object,
+                              const R_xlen_t         i_row,
+                              const bool             worker,
+                              Key_Cache&             key_cache,
+                              std::vector<R_xlen_t>& last_row) {
+        key_cache.for_each_field(
+            object, find_col, [&](const R_xlen_t i_col, simdjson::dom::element value) {
+                if (in_worker[i_col] != worker || last_row[i_col] == i_row) {
+                    return;
+                }
+                last_row[i_col] = i_row;
+
+                set_slot<type_policy, int64_opt, simplify_to>(
+                    slots[i_col], i_row, value, parse_opts);
+            });
+    };
+
+    if (n_threads == 1) {
+        auto key_cache = Key_Cache(n_cols);
+        auto last_row  = std::vector<R_xlen_t>(n_cols, -1);
+
+        auto i_row = R_xlen_t(0L);
+        for (auto element : array) {
+            simdjson::dom::object object;
+            if (element.get(object) == simdjson::SUCCESS) { // checked in diagnose_data_frame()
+                fill_row(object, i_row, false, key_cache, last_row);
             }
+            i_row++;
+        }
 
-            case rcpp_T::i64: {
-                out[col.index] =
-                    build_col_integer64<type_policy, int64_opt>(array, key, col.schema);
-                break;
-            }
+    } else {
+        /* workers need random access to the rows, which simdjson::dom::array doesn't offer */
+        auto objects = std::vector<simdjson::dom::object>(n_rows);
+        auto i_row   = R_xlen_t(0L);
+        for (auto element : array) {
+            (void)element.get(objects[i_row++]); // checked in diagnose_data_frame()
+        }
 
-            case rcpp_T::i32: {
-                out[col.index] =
-                    build_col<INTSXP, int64_t, rcpp_T::i32, type_policy>(array, key, col.schema);
-                break;
-            }
+#ifdef _OPENMP
+#    pragma omp parallel num_threads(n_threads)
+#endif
+        {
+            auto key_cache = Key_Cache(n_cols);
+            auto last_row  = std::vector<R_xlen_t>(n_cols, -1);
 
-            case rcpp_T::lgl: {
-                out[col.index] =
-                    build_col<LGLSXP, bool, rcpp_T::lgl, type_policy>(array, key, col.schema);
-                break;
+#ifdef _OPENMP
+#    pragma omp for schedule(static)
+#endif
+            for (R_xlen_t i = 0; i < n_rows; ++i) {
+                fill_row(objects[i], i, true, key_cache, last_row);
             }
+        }
 
-            case rcpp_T::null: {
-                out[col.index] = Rcpp::LogicalVector(n_rows, NA_LOGICAL);
-                break;
-            }
+        if (std::find(std::begin(in_worker), std::end(in_worker), false) != std::end(in_worker)) {
+            auto key_cache = Key_Cache(n_cols);
+            auto last_row  = std::vector<R_xlen_t>(n_cols, -1);
 
-            case rcpp_T::u64: {
-                out[col.index] =
-                    build_col<STRSXP, uint64_t, rcpp_T::chr, type_policy>(array, key, col.schema);
-                break;
+            for (R_xlen_t i = 0; i < n_rows; ++i) {
+                fill_row(objects[i], i, false, key_cache, last_row);
             }
+        }
+    }
 
-            default: {
-                auto this_col = Rcpp::Vector<VECSXP>(n_rows);
-                auto i_row    = R_xlen_t(0L);
-                for (auto element : array) {
-                    simdjson::dom::element lookup;
-                    if(element.get_object().at_key(key).get(lookup) == simdjson::SUCCESS) {
-                        this_col[i_row++] = simplify_element<type_policy, int64_opt, simplify_to>(
-                            lookup, empty_array, empty_object, single_null);
-                    } else {
-                        this_col[i_row++] = NA_LOGICAL;
-                    }
-                }
-                out[col.index] = this_col;
+    if constexpr (int64_opt == utils::Int64_R_Type::Integer64 ||
+                  int64_opt == utils::Int64_R_Type::Always) {
+        for (auto&& [key, col] : cols) {
+            if (slots[col.index].R_type == rcpp_T::i64) {
+                out[col.index] = utils::as_integer64(slots[col.index].integer64);
             }
         }
     }
+    for (auto&& [key, col] : cols) {
+        if (slots[col.index].factor) {
+            out[col.index] = finish_factor_col(slots[col.index]);
+        } else if (slots[col.index].is_lazy) {
+            out[col.index] = finish_lazy_col(slots[col.index], *parse_opts.lazy_strings);
+        }
+    }
 
     out.attr("names")     = out_names;
     out.attr("row.names") = Rcpp::seq(1, n_rows);
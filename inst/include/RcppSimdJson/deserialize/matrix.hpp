@@ -46,7 +46,8 @@ diagnose(simdjson::dom::array array) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
 
 template <int RTYPE, typename in_T, rcpp_T R_Type, bool has_nulls>
 inline Rcpp::Vector<RTYPE> build_matrix_typed(simdjson::dom::array array,
-                                              const std::size_t    n_cols) {
+                                              const std::size_t    n_cols,
+                                              String_Cache* const  string_cache = nullptr) {
     const R_xlen_t      n_rows = std::size(array);
     Rcpp::Matrix<RTYPE> out(n_rows, static_cast<R_xlen_t>(n_cols));
     R_xlen_t            j(0L);
@@ -56,7 +57,7 @@ inline Rcpp::Vector<RTYPE> build_matrix_typed(simdjson::dom::array array,
     for (simdjson::dom::array sub_array : array) {
         R_xlen_t i(0L);
         for (auto element : sub_array) {
-            out[i + j] = get_scalar<in_T, R_Type, has_nulls>(element);
+            out[i + j] = get_scalar<in_T, R_Type, has_nulls>(element, string_cache);
             i += n_rows;
         }
         j++;
@@ -67,7 +68,7 @@ inline Rcpp::Vector<RTYPE> build_matrix_typed(simdjson::dom::array array,
     for (simdjson::dom::array sub_array : array) {
         R_xlen_t i(0L);
         for (auto element : sub_array) {
-            out[i + j] = get_scalar<in_T, R_Type, has_nulls>(element);
+            out[i + j] = get_scalar<in_T, R_Type, has_nulls>(element, string_cache);
             i += n_rows;
         }
         j++;
@@ -121,14 +122,14 @@ inline SEXP dispatch_typed(simdjson::dom::array        array,
                            simdjson::dom::element_type element_type,
                            const rcpp_T                R_Type,
                            const bool                  has_nulls,
-                           const std::size_t           n_cols) {
+                           const std::size_t           n_cols,
+                           String_Cache* const         string_cache) {
     switch (element_type) {
         case simdjson::dom::element_type::STRING:
-            return has_nulls
-                       ? build_matrix_typed<STRSXP, std::string, rcpp_T::chr, HAS_NULLS>(array,
-                                                                                         n_cols)
-                       : build_matrix_typed<STRSXP, std::string, rcpp_T::chr, NO_NULLS>(array,
-                                                                                        n_cols);
+            return has_nulls ? build_matrix_typed<STRSXP, std::string, rcpp_T::chr, HAS_NULLS>(
+                                   array, n_cols, string_cache)
+                             : build_matrix_typed<STRSXP, std::string, rcpp_T::chr, NO_NULLS>(
+                                   array, n_cols, string_cache);
 
         case simdjson::dom::element_type::DOUBLE:
             return has_nulls
@@ -189,7 +190,9 @@ inline SEXP dispatch_typed(simdjson::dom::array        array,
 }
 
 template <int RTYPE>
-inline SEXP build_matrix_mixed(simdjson::dom::array array, std::size_t n_cols) {
+inline SEXP build_matrix_mixed(simdjson::dom::array array,
+                               std::size_t          n_cols,
+                               String_Cache* const  string_cache = nullptr) {
     const R_xlen_t      n_rows(std::size(array));
     Rcpp::Matrix<RTYPE> out(n_rows, static_cast<R_xlen_t>(n_cols));
     R_xlen_t            j(0L);
@@ -199,7 +202,7 @@ inline SEXP build_matrix_mixed(simdjson::dom::array array, std::size_t n_cols) {
     for (simdjson::dom::array sub_array : array) {
         R_xlen_t i(0L);
         for (auto&& element : sub_array) {
-            out[i + j] = get_scalar_dispatch<RTYPE>(element);
+            out[i + j] = get_scalar_dispatch<RTYPE>(element, string_cache);
             i += n_rows;
         }
         j++;
@@ -209,7 +212,7 @@ inline SEXP build_matrix_mixed(simdjson::dom::array array, std::size_t n_cols) {
     for (simdjson::dom::array sub_array : array) {
         R_xlen_t i(0L);
         for (auto element : sub_array) {
-            out[i + j] = get_scalar_dispatch<RTYPE>(element);
+            out[i + j] = get_scalar_dispatch<RTYPE>(element, string_cache);
             i += n_rows;
         }
         j++;
@@ -280,11 +283,13 @@ inline Rcpp::NumericVector build_matrix_integer64_mixed(simdjson::dom::array arr
 
 
 template <utils::Int64_R_Type int64_opt>
-inline SEXP
-dispatch_mixed(simdjson::dom::array array, const rcpp_T R_Type, const std::size_t n_cols) {
+inline SEXP dispatch_mixed(simdjson::dom::array array,
+                           const rcpp_T         R_Type,
+                           const std::size_t    n_cols,
+                           String_Cache* const  string_cache) {
     switch (R_Type) {
         case rcpp_T::chr:
-            return build_matrix_mixed<STRSXP>(array, n_cols);
+            return build_matrix_mixed<STRSXP>(array, n_cols, string_cache);
 
         case rcpp_T::dbl:
             return build_matrix_mixed<REALSXP>(array, n_cols);
@@ -295,7 +300,7 @@ dispatch_mixed(simdjson::dom::array array, const rcpp_T R_Type, const std::size_
             }
 
             if constexpr (int64_opt == utils::Int64_R_Type::String) {
-                return build_matrix_mixed<STRSXP>(array, n_cols);
+                return build_matrix_mixed<STRSXP>(array, n_cols, string_cache);
             }
 
             if constexpr (int64_opt == utils::Int64_R_Type::Integer64 ||
@@ -311,7 +316,7 @@ dispatch_mixed(simdjson::dom::array array, const rcpp_T R_Type, const std::size_
             return build_matrix_mixed<LGLSXP>(array, n_cols); // # nocov
 
         case rcpp_T::u64:
-            return build_matrix_mixed<STRSXP>(array, n_cols);
+            return build_matrix_mixed<STRSXP>(array, n_cols, string_cache);
 
         default: {
             auto out = Rcpp::LogicalMatrix(std::size(array), n_cols);
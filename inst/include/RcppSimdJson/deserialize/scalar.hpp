@@ -2,6 +2,8 @@
 #define RCPPSIMDJSON__DESERIALIZE__SCALAR_HPP
 
 #include "Type_Doctor.hpp"
+#include "String_Cache.hpp"
+#include "Lazy_Strings.hpp"
 
 namespace rcppsimdjson {
 namespace deserialize {
@@ -20,9 +22,22 @@ static inline constexpr bool NO_NULLS = false;
 template <typename in_T, rcpp_T R_Type>
 inline auto get_scalar_(simdjson::dom::element) noexcept(noxcpt<R_Type>());
 
+/*
+ * `std::string`s (really std::string_view s) become CHARSXPs, unprotected unless interned by
+ * `string_cache` (see `make_charsxp()`).
+ */
 template <typename in_T, rcpp_T R_Type, bool has_null>
-inline auto get_scalar(simdjson::dom::element element) noexcept(noxcpt<R_Type>()) {
-    if constexpr (has_null) {
+inline auto get_scalar(simdjson::dom::element element,
+                       String_Cache* const    string_cache = nullptr) noexcept(noxcpt<R_Type>()) {
+    if constexpr (std::is_same_v<in_T, std::string>) {
+        static_assert(R_Type == rcpp_T::chr);
+        if constexpr (has_null) {
+            return element.is_null() ? na_val<R_Type>()
+                                     : make_charsxp(std::string_view(element), string_cache);
+        } else {
+            return make_charsxp(std::string_view(element), string_cache);
+        }
+    } else if constexpr (has_null) {
         return element.is_null() ? na_val<R_Type>() : get_scalar_<in_T, R_Type>(element);
     } else {
         return get_scalar_<in_T, R_Type>(element);
@@ -101,13 +116,6 @@ inline auto
 get_scalar_<double, rcpp_T::dbl>(simdjson::dom::element element) noexcept(noxcpt<rcpp_T::dbl>()) {
     return double(element);
 }
-// std::string (really std::string_view) ===========================================================
-// return Rcpp::String
-template <>
-inline auto get_scalar_<std::string, rcpp_T::chr>(simdjson::dom::element element) noexcept(
-    noxcpt<rcpp_T::chr>()) {
-    return Rcpp::String(std::string(std::string_view(element)));
-}
 // uint64_t ========================================================================================
 // return Rcpp::String
 template <>
@@ -117,13 +125,16 @@ get_scalar_<uint64_t, rcpp_T::chr>(simdjson::dom::element element) noexcept(noxc
 }
 // dispatchers =====================================================================================
 template <int RTYPE>
-inline auto get_scalar_dispatch(simdjson::dom::element) noexcept(noxcpt<RTYPE>());
+inline auto get_scalar_dispatch(simdjson::dom::element,
+                                String_Cache* string_cache = nullptr) noexcept(noxcpt<RTYPE>());
 
 template <>
-inline auto get_scalar_dispatch<STRSXP>(simdjson::dom::element element) noexcept(false) {
+inline auto get_scalar_dispatch<STRSXP>(simdjson::dom::element element,
+                                        String_Cache* const    string_cache) noexcept(false) {
     switch (element.type()) {
         case simdjson::dom::element_type::STRING:
-            return get_scalar<std::string, rcpp_T::chr, NO_NULLS>(element);
+            return Rcpp::String(
+                get_scalar<std::string, rcpp_T::chr, NO_NULLS>(element, string_cache));
 
         case simdjson::dom::element_type::DOUBLE:
             return get_scalar<double, rcpp_T::chr, NO_NULLS>(element);
@@ -145,7 +156,8 @@ inline auto get_scalar_dispatch<STRSXP>(simdjson::dom::element element) noexcept
 
 template <>
 inline auto
-get_scalar_dispatch<REALSXP>(simdjson::dom::element element) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
+get_scalar_dispatch<REALSXP>(simdjson::dom::element element,
+                             String_Cache*) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
     switch (element.type()) {
         case simdjson::dom::element_type::DOUBLE:
             return get_scalar<double, rcpp_T::dbl, NO_NULLS>(element);
@@ -164,7 +176,8 @@ get_scalar_dispatch<REALSXP>(simdjson::dom::element element) noexcept(RCPPSIMDJS
 
 template <>
 inline auto
-get_scalar_dispatch<INTSXP>(simdjson::dom::element element) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
+get_scalar_dispatch<INTSXP>(simdjson::dom::element element,
+                            String_Cache*) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
     switch (element.type()) {
         case simdjson::dom::element_type::INT64:
             return get_scalar<int64_t, rcpp_T::i32, NO_NULLS>(element);
@@ -180,7 +193,8 @@ get_scalar_dispatch<INTSXP>(simdjson::dom::element element) noexcept(RCPPSIMDJSO
 // # nocov start
 template <>
 inline auto
-get_scalar_dispatch<LGLSXP>(simdjson::dom::element element) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
+get_scalar_dispatch<LGLSXP>(simdjson::dom::element element,
+                            String_Cache*) noexcept(RCPPSIMDJSON_NO_EXCEPTIONS) {
     switch (element.type()) {
         case simdjson::dom::element_type::BOOL:
             return get_scalar<bool, rcpp_T::i32, NO_NULLS>(element);
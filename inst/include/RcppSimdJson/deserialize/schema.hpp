@@ -0,0 +1,296 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__SCHEMA_HPP
+#define RCPPSIMDJSON__DESERIALIZE__SCHEMA_HPP
+
+
+#include "dataframe.hpp"
+
+#include <cmath>         /* std::trunc */
+#include <unordered_map> /* std::unordered_map */
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief The R type of a column declared in a `schema=`. Matches the order of `.schema_types` in
+ * R/utils.R .
+ */
+enum class Col_Type : int {
+    lgl   = 0, /* logical */
+    i32   = 1, /* integer */
+    dbl   = 2, /* double */
+    chr   = 3, /* character */
+    i64   = 4, /* bit64::integer64 */
+    list  = 5, /* list, each element deserialized as usual */
+};
+
+
+/**
+ * @brief A compiled `schema=`: the columns to extract from each record, in order, and their types.
+ *
+ * Keys are views into the CHARSXPs of `schema`'s names, which the Schema keeps alive, so no key is
+ * ever copied.
+ */
+class Schema {
+    Rcpp::CharacterVector                          names_;
+    std::vector<Col_Type>                          types_;
+    std::unordered_map<std::string_view, R_xlen_t> index_;
+
+  public:
+    /**
+     * @param schema A named `integer` vector of `Col_Type`s, as prepared by `.prep_schema()`.
+     */
+    explicit Schema(SEXP schema) : names_(Rf_getAttrib(schema, R_NamesSymbol)) {
+        const auto types = Rcpp::IntegerVector(schema);
+        types_.reserve(std::size(types));
+        index_.reserve(std::size(types));
+
+        for (R_xlen_t i = 0; i < std::size(types); ++i) {
+            if (types[i] < static_cast<int>(Col_Type::lgl) ||
+                types[i] > static_cast<int>(Col_Type::list)) {
+                Rcpp::stop("Invalid `schema=` type."); // # nocov
+            }
+            types_.push_back(static_cast<Col_Type>(types[i]));
+            index_.emplace(std::string_view(CHAR(STRING_ELT(names_, i))), i);
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> R_xlen_t { return std::size(types_); }
+    [[nodiscard]] auto names() const noexcept -> const Rcpp::CharacterVector& { return names_; }
+    [[nodiscard]] auto type(const R_xlen_t i_col) const noexcept -> Col_Type {
+        return types_[i_col];
+    }
+
+    /** @brief The column of `key`, or -1 if `key` isn't part of the schema. */
+    [[nodiscard]] auto find(const std::string_view key) const noexcept -> R_xlen_t {
+        const auto it = index_.find(key);
+        return it == std::end(index_) ? -1 : it->second;
+    }
+};
+
+
+// coercion ========================================================================================
+/* values that can't be coerced to a column's type (including containers and `null`) become `NA` */
+
+inline auto coerce_lgl(simdjson::dom::element element) noexcept -> int {
+    switch (element.type()) {
+        case simdjson::dom::element_type::BOOL:
+            return bool(element);
+        case simdjson::dom::element_type::INT64:
+            return int64_t(element) != 0;
+        case simdjson::dom::element_type::UINT64:
+            return true;
+        case simdjson::dom::element_type::DOUBLE:
+            return double(element) != 0;
+        default:
+            return NA_LOGICAL;
+    }
+}
+
+
+/* as in `as.integer()`, doubles are truncated and anything out of range is `NA` */
+inline auto coerce_i32(simdjson::dom::element element) noexcept -> int {
+    switch (element.type()) {
+        case simdjson::dom::element_type::INT64: {
+            const auto x = int64_t(element);
+            return utils::is_castable_int64(x) ? static_cast<int>(x) : NA_INTEGER;
+        }
+        case simdjson::dom::element_type::DOUBLE: {
+            const auto x = std::trunc(double(element));
+            return x <= std::numeric_limits<int>::max() && x > std::numeric_limits<int>::min()
+                       ? static_cast<int>(x)
+                       : NA_INTEGER;
+        }
+        case simdjson::dom::element_type::BOOL:
+            return bool(element);
+        default:
+            return NA_INTEGER;
+    }
+}
+
+
+inline auto coerce_dbl(simdjson::dom::element element) noexcept -> double {
+    switch (element.type()) {
+        case simdjson::dom::element_type::DOUBLE:
+            return double(element);
+        case simdjson::dom::element_type::INT64:
+            return static_cast<double>(int64_t(element));
+        case simdjson::dom::element_type::UINT64:
+            return static_cast<double>(uint64_t(element));
+        case simdjson::dom::element_type::BOOL:
+            return bool(element);
+        default:
+            return NA_REAL;
+    }
+}
+
+
+inline auto coerce_i64(simdjson::dom::element element) noexcept -> int64_t {
+    switch (element.type()) {
+        case simdjson::dom::element_type::INT64:
+            return int64_t(element);
+        case simdjson::dom::element_type::DOUBLE: {
+            /* 2^63 itself doesn't fit */
+            const auto x = std::trunc(double(element));
+            return x < 9223372036854775808.0 && x > static_cast<double>(NA_INTEGER64)
+                       ? static_cast<int64_t>(x)
+                       : NA_INTEGER64;
+        }
+        case simdjson::dom::element_type::BOOL:
+            return bool(element);
+        default:
+            return NA_INTEGER64;
+    }
+}
+
+
+/* scalars are formatted as in mixed-type vectors, arrays and objects become minified JSON */
+inline auto coerce_chr(simdjson::dom::element element, String_Cache* const string_cache) -> SEXP {
+    switch (element.type()) {
+        case simdjson::dom::element_type::STRING:
+            return get_scalar<std::string, rcpp_T::chr, NO_NULLS>(element, string_cache);
+        case simdjson::dom::element_type::NULL_VALUE:
+            return NA_STRING;
+        case simdjson::dom::element_type::ARRAY:
+        case simdjson::dom::element_type::OBJECT:
+            /* not interned: a String_Cache key must point into the document itself */
+            return String_Cache::make(simdjson::minify(element));
+        default:
+            return get_scalar_dispatch<STRSXP>(element).get_sexp();
+    }
+}
+
+
+// building ========================================================================================
+/**
+ * @brief Build a data frame with exactly the columns of `schema` from `element`, an array of
+ * records (or a single record), in a single pass.
+ *
+ * Nothing is diagnosed: every column is allocated up front with its declared type and `NA`s, then
+ * each record's fields are coerced straight into their column. Fields that aren't part of the
+ * schema are skipped, and array elements that aren't objects become rows of `NA`s.
+ *
+ * @param string_cache The document's String_Cache (if any), which interns `chr` cells.
+ *
+ * @param deserialize_cell Callable taking a simdjson::dom::element and returning a SEXP , used for
+ * `list` columns.
+ */
+template <typename deserialize_T>
+inline auto build_schema_data_frame(simdjson::dom::element element,
+                                    const Schema&          schema,
+                                    String_Cache* const    string_cache,
+                                    const deserialize_T&   deserialize_cell) -> SEXP {
+    simdjson::dom::array  array;
+    simdjson::dom::object single_record;
+    const auto            is_single = element.get(single_record) == simdjson::SUCCESS;
+    if (!is_single && element.get(array) != simdjson::SUCCESS) {
+        Rcpp::stop("`schema=` requires an array of objects or a single object.");
+    }
+
+    const auto n_rows  = is_single ? R_xlen_t(1) : R_xlen_t(std::size(array));
+    const auto n_cols  = schema.size();
+    const auto na_cell = Rcpp::IntegerVector(1, NA_INTEGER); /* as in `build_data_frame()` */
+
+    auto out       = Rcpp::List(n_cols);
+    auto integer64 = std::vector<std::vector<int64_t>>(n_cols);
+    for (R_xlen_t i_col = 0; i_col < n_cols; ++i_col) {
+        switch (schema.type(i_col)) {
+            case Col_Type::lgl:
+                out[i_col] = Rcpp::LogicalVector(n_rows, NA_LOGICAL);
+                break;
+            case Col_Type::i32:
+                out[i_col] = Rcpp::IntegerVector(n_rows, NA_INTEGER);
+                break;
+            case Col_Type::dbl:
+                out[i_col] = Rcpp::NumericVector(n_rows, NA_REAL);
+                break;
+            case Col_Type::chr:
+                out[i_col] = Rcpp::CharacterVector(n_rows, NA_STRING);
+                break;
+            case Col_Type::i64:
+                integer64[i_col] = std::vector<int64_t>(n_rows, NA_INTEGER64);
+                break;
+            case Col_Type::list: {
+                auto this_col = Rcpp::List(n_rows);
+                for (R_xlen_t i_row = 0; i_row < n_rows; ++i_row) {
+                    SET_VECTOR_ELT(this_col, i_row, na_cell);
+                }
+                out[i_col] = this_col;
+            }
+        }
+    }
+
+    /* raw column pointers, since `out` is fully allocated */
+    auto cols = std::vector<SEXP>(n_cols);
+    for (R_xlen_t i_col = 0; i_col < n_cols; ++i_col) {
+        cols[i_col] = VECTOR_ELT(out, i_col);
+    }
+
+    auto       key_cache = Key_Cache(n_cols);
+    auto       last_row  = std::vector<R_xlen_t>(n_cols, -1);
+    const auto find_col  = [&schema](const std::string_view key) { return schema.find(key); };
+
+    const auto fill_row = [&](simdjson::dom::object record, const R_xlen_t i_row) {
+        key_cache.for_each_field(
+            record, find_col, [&](const R_xlen_t i_col, simdjson::dom::element value) {
+                if (i_col < 0 || last_row[i_col] == i_row) { /* not in schema, or a duplicate */
+                    return;
+                }
+                last_row[i_col] = i_row;
+
+                switch (schema.type(i_col)) {
+                    case Col_Type::lgl:
+                        LOGICAL(cols[i_col])[i_row] = coerce_lgl(value);
+                        break;
+                    case Col_Type::i32:
+                        INTEGER(cols[i_col])[i_row] = coerce_i32(value);
+                        break;
+                    case Col_Type::dbl:
+                        REAL(cols[i_col])[i_row] = coerce_dbl(value);
+                        break;
+                    case Col_Type::chr:
+                        SET_STRING_ELT(cols[i_col], i_row, coerce_chr(value, string_cache));
+                        break;
+                    case Col_Type::i64:
+                        integer64[i_col][i_row] = coerce_i64(value);
+                        break;
+                    case Col_Type::list:
+                        SET_VECTOR_ELT(cols[i_col], i_row, deserialize_cell(value));
+                }
+            });
+    };
+
+    if (is_single) {
+        fill_row(single_record, 0);
+    } else {
+        auto i_row = R_xlen_t(0L);
+        for (auto row : array) {
+            simdjson::dom::object record;
+            if (row.get(record) == simdjson::SUCCESS) {
+                fill_row(record, i_row);
+            }
+            i_row++;
+        }
+    }
+
+    for (R_xlen_t i_col = 0; i_col < n_cols; ++i_col) {
+        if (schema.type(i_col) == Col_Type::i64) {
+            out[i_col] = utils::as_integer64(integer64[i_col]);
+        }
+    }
+
+    out.attr("names")     = schema.names();
+    out.attr("row.names") = n_rows == 0 ? Rcpp::IntegerVector(0)
+                                        : Rcpp::IntegerVector(Rcpp::seq(1, n_rows));
+    out.attr("class")     = "data.frame";
+
+    return out;
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
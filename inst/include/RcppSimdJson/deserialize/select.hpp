@@ -0,0 +1,169 @@
+#ifndef RCPPSIMDJSON__DESERIALIZE__SELECT_HPP
+#define RCPPSIMDJSON__DESERIALIZE__SELECT_HPP
+
+
+#include "dataframe.hpp"
+
+#include <string>        /* std::string */
+#include <unordered_map> /* std::unordered_map */
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief A compiled `select=`: the fields to extract from each record, in order, and the names of
+ * the columns they become.
+ *
+ * Fields are either top-level keys, looked up in a single walk over each record, or JSON Pointers
+ * (starting with `/`) relative to each record. Keys are views into the CHARSXPs of `select`, which
+ * the Selection keeps alive.
+ */
+class Selection {
+    Rcpp::CharacterVector                          fields_;
+    Rcpp::CharacterVector                          names_;
+    std::unordered_map<std::string_view, R_xlen_t> keys_;
+    std::vector<std::pair<std::string, R_xlen_t>>  pointers_;
+
+  public:
+    /**
+     * @param select A named `character` vector of distinct keys and JSON Pointers, as prepared by
+     * `.prep_select()`.
+     */
+    explicit Selection(SEXP select)
+        : fields_(select), names_(Rf_getAttrib(select, R_NamesSymbol)) {
+        keys_.reserve(std::size(fields_));
+
+        for (R_xlen_t i = 0; i < std::size(fields_); ++i) {
+            const auto field = std::string_view(CHAR(STRING_ELT(fields_, i)));
+            if (!field.empty() && field.front() == '/') {
+                pointers_.emplace_back(field, i);
+            } else if (!keys_.emplace(field, i).second) {
+                Rcpp::stop("`select=` selects '" + std::string(field) + "' more than once.");
+            }
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> R_xlen_t { return std::size(fields_); }
+    [[nodiscard]] auto names() const noexcept -> const Rcpp::CharacterVector& { return names_; }
+    [[nodiscard]] auto has_keys() const noexcept -> bool { return !keys_.empty(); }
+    [[nodiscard]] auto pointers() const noexcept -> const auto& { return pointers_; }
+
+    /** @brief The column of top-level `key`, or -1 if `key` isn't selected. */
+    [[nodiscard]] auto find(const std::string_view key) const noexcept -> R_xlen_t {
+        const auto it = keys_.find(key);
+        return it == std::end(keys_) ? -1 : it->second;
+    }
+};
+
+
+/**
+ * @brief Build a data frame with exactly the columns of `selection` from `element`, an array of
+ * records (or a single record).
+ *
+ * Each record is walked once to find the selected fields, which are diagnosed as they are found;
+ * nothing else in the record is ever looked at. Each column is then filled straight from the
+ * fields found for it, so unselected subtrees never become R objects. Missing fields, and array
+ * elements that aren't objects, become `NA`s.
+ */
+template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
+inline auto build_selected_data_frame(simdjson::dom::element element,
+                                      const Selection&       selection,
+                                      const Parse_Opts&      parse_opts) -> SEXP {
+    simdjson::dom::array  array;
+    simdjson::dom::object single_record;
+    const auto            is_single = element.get(single_record) == simdjson::SUCCESS;
+    if (!is_single && element.get(array) != simdjson::SUCCESS) {
+        Rcpp::stop("`select=` requires an array of objects or a single object.");
+    }
+
+    const auto n_rows = is_single ? R_xlen_t(1) : R_xlen_t(std::size(array));
+    const auto n_cols = selection.size();
+
+    /* the field found for each cell (column-major), if any */
+    auto cells   = std::vector<simdjson::dom::element>(n_rows * n_cols);
+    auto found   = std::vector<bool>(n_rows * n_cols);
+    auto doctors = std::vector<Type_Doctor<type_policy, int64_opt>>(n_cols);
+
+    auto       key_cache = Key_Cache(n_cols);
+    const auto find_col  = [&selection](const std::string_view key) { return selection.find(key); };
+
+    const auto find_fields = [&](simdjson::dom::object record, const R_xlen_t i_row) {
+        const auto add_cell = [&](const R_xlen_t i_col, simdjson::dom::element value) {
+            if (i_col < 0) {
+                return;
+            }
+            if (const auto i_cell = i_col * n_rows + i_row; !found[i_cell]) {
+                cells[i_cell] = value;
+                found[i_cell] = true;
+                doctors[i_col].add_element(value);
+            }
+        };
+
+        if (selection.has_keys()) {
+            key_cache.for_each_field(record, find_col, add_cell);
+        }
+
+        for (const auto& [pointer, i_col] : selection.pointers()) {
+            simdjson::dom::element value;
+            if (record.at_pointer(pointer).get(value) == simdjson::SUCCESS) {
+                add_cell(i_col, value);
+            }
+        }
+    };
+
+    if (is_single) {
+        find_fields(single_record, 0);
+    } else {
+        auto i_row = R_xlen_t(0L);
+        for (auto row : array) {
+            simdjson::dom::object record;
+            if (row.get(record) == simdjson::SUCCESS) {
+                find_fields(record, i_row);
+            }
+            i_row++;
+        }
+    }
+
+    auto       out     = Rcpp::List(n_cols);
+    const auto na_cell = Rcpp::IntegerVector(1, NA_INTEGER);
+    for (R_xlen_t i_col = 0; i_col < n_cols; ++i_col) {
+        auto slot =
+            allocate_col<type_policy, int64_opt>(doctors[i_col], n_rows, na_cell, parse_opts);
+        out[i_col] = slot.values;
+
+        for (R_xlen_t i_row = 0, i_cell = i_col * n_rows; i_row < n_rows; ++i_row, ++i_cell) {
+            if (found[i_cell]) {
+                set_slot<type_policy, int64_opt, simplify_to>(
+                    slot, i_row, cells[i_cell], parse_opts);
+            }
+        }
+
+        if constexpr (int64_opt == utils::Int64_R_Type::Integer64 ||
+                      int64_opt == utils::Int64_R_Type::Always) {
+            if (slot.R_type == rcpp_T::i64) {
+                out[i_col] = utils::as_integer64(slot.integer64);
+            }
+        }
+        if (slot.factor) {
+            out[i_col] = finish_factor_col(slot);
+        } else if (slot.is_lazy) {
+            out[i_col] = finish_lazy_col(slot, *parse_opts.lazy_strings);
+        }
+    }
+
+    out.attr("names")     = selection.names();
+    out.attr("row.names") = n_rows == 0 ? Rcpp::IntegerVector(0)
+                                        : Rcpp::IntegerVector(Rcpp::seq(1, n_rows));
+    out.attr("class")     = "data.frame";
+
+    return out;
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -15,104 +15,87 @@ namespace deserialize {
 
 
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP
-simplify_list(simdjson::dom::array array, SEXP empty_array, SEXP empty_object, SEXP single_null) {
+inline SEXP simplify_list(simdjson::dom::array array, const Parse_Opts& parse_opts) {
     Rcpp::List out(r_length(array));
     auto i = R_xlen_t(0);
     for (auto element : array) {
-        out[i++] = simplify_element<type_policy, int64_opt, simplify_to>(
-            element, empty_array, empty_object, single_null);
+        out[i++] = simplify_element<type_policy, int64_opt, simplify_to>(element, parse_opts);
     }
     return out;
 }
 
 
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP
-simplify_vector(simdjson::dom::array array, SEXP empty_array, SEXP empty_object, SEXP single_null) {
+inline SEXP simplify_vector(simdjson::dom::array array, const Parse_Opts& parse_opts) {
     if (const auto type_doctor = Type_Doctor<type_policy, int64_opt>(array);
         type_doctor.is_vectorizable()) {
         return type_doctor.is_homogeneous()
                    ? vector::dispatch_typed<int64_opt>(
-                         array, type_doctor.common_R_type(), type_doctor.has_null())
-                   : vector::dispatch_mixed<int64_opt>(array, type_doctor.common_R_type());
+                         array, type_doctor.common_R_type(), type_doctor.has_null(), parse_opts)
+                   : vector::dispatch_mixed<int64_opt>(
+                         array, type_doctor.common_R_type(), parse_opts);
     }
-    return simplify_list<type_policy, int64_opt, simplify_to>(
-        array, empty_array, empty_object, single_null);
+    return simplify_list<type_policy, int64_opt, simplify_to>(array, parse_opts);
 }
 
 
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP
-simplify_matrix(simdjson::dom::array array, SEXP empty_array, SEXP empty_object, SEXP single_null) {
+inline SEXP simplify_matrix(simdjson::dom::array array, const Parse_Opts& parse_opts) {
     if (const auto matrix = matrix::diagnose<type_policy, int64_opt>(array)) {
         return matrix->is_homogeneous
                    ? matrix::dispatch_typed<int64_opt>(array,
                                                        matrix->common_element_type,
                                                        matrix->common_R_type,
                                                        matrix->has_nulls,
-                                                       matrix->n_cols)
+                                                       matrix->n_cols,
+                                                       parse_opts.string_cache)
                    : matrix::dispatch_mixed<int64_opt>(
-                         array, matrix->common_R_type, matrix->n_cols);
+                         array, matrix->common_R_type, matrix->n_cols, parse_opts.string_cache);
     }
-    return simplify_vector<type_policy, int64_opt, simplify_to>(
-        array, empty_array, empty_object, single_null);
+    return simplify_vector<type_policy, int64_opt, simplify_to>(array, parse_opts);
 }
 
 
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP simplify_data_frame(simdjson::dom::array array,
-                                SEXP                 empty_array,
-                                SEXP                 empty_object,
-                                SEXP                 single_null) {
+inline SEXP simplify_data_frame(simdjson::dom::array array, const Parse_Opts& parse_opts) {
     if (const auto cols = diagnose_data_frame<type_policy, int64_opt>(array)) {
         return build_data_frame<type_policy, int64_opt, simplify_to>(
-            array, cols->schema, empty_array, empty_object, single_null);
+            array, cols->schema, parse_opts);
     }
-    return simplify_matrix<type_policy, int64_opt, simplify_to>(
-        array, empty_array, empty_object, single_null);
+    return simplify_matrix<type_policy, int64_opt, simplify_to>(array, parse_opts);
 }
 
 
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP dispatch_simplify_array(simdjson::dom::array array,
-                                    SEXP                 empty_array,
-                                    SEXP                 empty_object,
-                                    SEXP                 single_null) {
+inline SEXP dispatch_simplify_array(simdjson::dom::array array, const Parse_Opts& parse_opts) {
     if (std::size(array) == 0) {
-        return empty_array;
+        return parse_opts.empty_array;
     }
 
     if constexpr (simplify_to == Simplify_To::data_frame) {
-        return simplify_data_frame<type_policy, int64_opt, Simplify_To::data_frame>(
-            array, empty_array, empty_object, single_null);
+        return simplify_data_frame<type_policy, int64_opt, Simplify_To::data_frame>(array,
+                                                                                    parse_opts);
     }
 
     if constexpr (simplify_to == Simplify_To::matrix) {
-        return simplify_matrix<type_policy, int64_opt, Simplify_To::matrix>(
-            array, empty_array, empty_object, single_null);
+        return simplify_matrix<type_policy, int64_opt, Simplify_To::matrix>(array, parse_opts);
     }
 
     if constexpr (simplify_to == Simplify_To::vector) {
-        return simplify_vector<type_policy, int64_opt, Simplify_To::vector>(
-            array, empty_array, empty_object, single_null);
+        return simplify_vector<type_policy, int64_opt, Simplify_To::vector>(array, parse_opts);
     }
 
     if constexpr (simplify_to == Simplify_To::list) {
-        return simplify_list<type_policy, int64_opt, Simplify_To::list>(
-            array, empty_array, empty_object, single_null);
+        return simplify_list<type_policy, int64_opt, Simplify_To::list>(array, parse_opts);
     }
 }
 
 
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP simplify_object(const simdjson::dom::object object,
-                            SEXP                        empty_array,
-                            SEXP                        empty_object,
-                            SEXP                        single_null) {
+inline SEXP simplify_object(const simdjson::dom::object object, const Parse_Opts& parse_opts) {
     const auto n = r_length(object);
     if (n == 0) {
-        return empty_object;
+        return parse_opts.empty_object;
     }
 
     Rcpp::List            out(n);
@@ -120,9 +103,8 @@ inline SEXP simplify_object(const simdjson::dom::object object,
 
     auto i = R_xlen_t(0L);
     for (auto [key, value] : object) {
-        out[i] = simplify_element<type_policy, int64_opt, simplify_to>(
-            value, empty_array, empty_object, single_null);
-        out_names[i++] = Rcpp::String(std::string(key));
+        out[i]         = simplify_element<type_policy, int64_opt, simplify_to>(value, parse_opts);
+        out_names[i++] = make_charsxp(key, parse_opts.string_cache);
     }
 
     out.attr("names") = out_names;
@@ -144,9 +126,8 @@ inline SEXP simplify_object(const simdjson::dom::object object,
  *
  * @param element @c simdjson::dom::element to simplify.
  *
- * @param empty_array R object to return when encountering an empty JSON array.
- *
- * @param empty_object R object to return when encountering an empty JSON object.
+ * @param parse_opts @c Parse_Opts with the R objects to return for empty JSON arrays, empty JSON
+ * objects and single @c null s, and the document's @c String_Cache .
  *
  *
  * @return The simplified R object ( @c SEXP ).
@@ -155,18 +136,15 @@ inline SEXP simplify_object(const simdjson::dom::object object,
  * @note definition: forward declaration in @file inst/include/RcppSimdJson/common.hpp @file.
  */
 template <Type_Policy type_policy, utils::Int64_R_Type int64_opt, Simplify_To simplify_to>
-inline SEXP simplify_element(simdjson::dom::element element,
-                             SEXP                   empty_array,
-                             SEXP                   empty_object,
-                             SEXP                   single_null) {
+inline SEXP simplify_element(simdjson::dom::element element, const Parse_Opts& parse_opts) {
     switch (element.type()) {
         case simdjson::dom::element_type::ARRAY:
             return dispatch_simplify_array<type_policy, int64_opt, simplify_to>(
-                simdjson::dom::array(element), empty_array, empty_object, single_null);
+                simdjson::dom::array(element), parse_opts);
 
         case simdjson::dom::element_type::OBJECT:
             return simplify_object<type_policy, int64_opt, simplify_to>(
-                simdjson::dom::object(element), empty_array, empty_object, single_null);
+                simdjson::dom::object(element), parse_opts);
 
         case simdjson::dom::element_type::DOUBLE:
             return Rcpp::wrap(double(element));
@@ -178,10 +156,11 @@ inline SEXP simplify_element(simdjson::dom::element element,
             return Rcpp::wrap(bool(element));
 
         case simdjson::dom::element_type::STRING:
-            return Rcpp::wrap(Rcpp::String(std::string(std::string_view(element))));
+            return Rf_ScalarString(Rcpp::Shield<SEXP>(
+                make_charsxp(std::string_view(element), parse_opts.string_cache)));
 
         case simdjson::dom::element_type::NULL_VALUE:
-            return single_null;
+            return parse_opts.single_null;
 
         case simdjson::dom::element_type::UINT64:
             return Rcpp::wrap(std::to_string(uint64_t(element)));
@@ -1,6 +1,7 @@
 #ifndef RCPPSIMDJSON__DESERIALIZE__VECTOR_HPP
 #define RCPPSIMDJSON__DESERIALIZE__VECTOR_HPP
 
+#include "Factors.hpp"
 #include "scalar.hpp"
 
 namespace rcppsimdjson {
@@ -9,16 +10,55 @@ namespace vector {
 
 
 template <int RTYPE, typename in_T, rcpp_T R_Type, bool has_nulls>
-inline Rcpp::Vector<RTYPE> build_vector_typed(simdjson::dom::array array) {
+inline Rcpp::Vector<RTYPE> build_vector_typed(simdjson::dom::array array,
+                                              String_Cache* const  string_cache = nullptr) {
     Rcpp::Vector<RTYPE> out(std::size(array));
     R_xlen_t            i(0L);
     for (auto element : array) {
-        out[i++] = get_scalar<in_T, R_Type, has_nulls>(element);
+        out[i++] = get_scalar<in_T, R_Type, has_nulls>(element, string_cache);
     }
     return out;
 }
 
 
+/**
+ * @brief A factor of a `chr` array's strings, or `R_NilValue` as soon as it has more than
+ * `parse_opts.max_factor_levels` levels.
+ */
+inline SEXP build_vector_factor(simdjson::dom::array array, const Parse_Opts& parse_opts) {
+    auto       factor = Factor_Builder(parse_opts);
+    auto       codes  = Rcpp::IntegerVector(std::size(array), NA_INTEGER);
+    int* const out    = INTEGER(codes);
+    R_xlen_t   i(0L);
+    for (auto element : array) {
+        if (element.is_string()) {
+            out[i] = factor.code(std::string_view(element));
+            if (!factor.fits()) {
+                return R_NilValue;
+            }
+        }
+        ++i;
+    }
+    return factor.finish(codes);
+}
+
+
+/**
+ * @brief A `chr` vector whose strings are materialized on access (see `Lazy_Strings`).
+ */
+inline SEXP build_vector_lazy_strings(simdjson::dom::array array, const Lazy_Strings& lazy) {
+    std::vector<std::string_view> strings(std::size(array));
+    std::size_t                   i(0ULL);
+    for (auto element : array) {
+        if (element.is_string()) {
+            strings[i] = Lazy_Strings::view(std::string_view(element));
+        }
+        ++i;
+    }
+    return make_lazy_strings(std::move(strings), lazy);
+}
+
+
 template <bool has_nulls>
 inline Rcpp::Vector<REALSXP> build_vector_integer64_typed(simdjson::dom::array array) {
     std::vector<int64_t> stl_vec_int64(std::size(array));
@@ -31,12 +71,24 @@ inline Rcpp::Vector<REALSXP> build_vector_integer64_typed(simdjson::dom::array a
 
 
 template <utils::Int64_R_Type int64_opt>
-inline SEXP dispatch_typed(simdjson::dom::array array, const rcpp_T R_Type, const bool has_nulls) {
+inline SEXP dispatch_typed(simdjson::dom::array array,
+                           const rcpp_T         R_Type,
+                           const bool           has_nulls,
+                           const Parse_Opts&    parse_opts) {
     switch (R_Type) {
         case rcpp_T::chr:
-            return has_nulls
-                       ? build_vector_typed<STRSXP, std::string, rcpp_T::chr, HAS_NULLS>(array)
-                       : build_vector_typed<STRSXP, std::string, rcpp_T::chr, NO_NULLS>(array);
+            if (parse_opts.max_factor_levels > 0) {
+                if (SEXP factor = build_vector_factor(array, parse_opts); factor != R_NilValue) {
+                    return factor;
+                }
+            }
+            if (parse_opts.lazy_strings) {
+                return build_vector_lazy_strings(array, *parse_opts.lazy_strings);
+            }
+            return has_nulls ? build_vector_typed<STRSXP, std::string, rcpp_T::chr, HAS_NULLS>(
+                                   array, parse_opts.string_cache)
+                             : build_vector_typed<STRSXP, std::string, rcpp_T::chr, NO_NULLS>(
+                                   array, parse_opts.string_cache);
 
         case rcpp_T::dbl:
             return has_nulls ? build_vector_typed<REALSXP, double, rcpp_T::dbl, HAS_NULLS>(array)
@@ -81,11 +133,12 @@ inline SEXP dispatch_typed(simdjson::dom::array array, const rcpp_T R_Type, cons
 
 
 template <int RTYPE>
-inline Rcpp::Vector<RTYPE> build_vector_mixed(simdjson::dom::array array) {
+inline Rcpp::Vector<RTYPE> build_vector_mixed(simdjson::dom::array array,
+                                              String_Cache* const  string_cache = nullptr) {
     Rcpp::Vector<RTYPE> out(std::size(array));
     R_xlen_t            i(0L);
     for (auto element : array) {
-        out[i++] = get_scalar_dispatch<RTYPE>(element);
+        out[i++] = get_scalar_dispatch<RTYPE>(element, string_cache);
     }
     return out;
 }
@@ -116,10 +169,12 @@ inline Rcpp::Vector<REALSXP> build_vector_integer64_mixed(simdjson::dom::array a
 
 
 template <utils::Int64_R_Type int64_opt>
-inline SEXP dispatch_mixed(simdjson::dom::array array, const rcpp_T common_R_type) {
+inline SEXP dispatch_mixed(simdjson::dom::array array,
+                           const rcpp_T         common_R_type,
+                           const Parse_Opts&    parse_opts) {
     switch (common_R_type) {
         case rcpp_T::chr:
-            return build_vector_mixed<STRSXP>(array);
+            return build_vector_mixed<STRSXP>(array, parse_opts.string_cache);
 
         case rcpp_T::dbl:
             return build_vector_mixed<REALSXP>(array);
@@ -130,7 +185,7 @@ inline SEXP dispatch_mixed(simdjson::dom::array array, const rcpp_T common_R_typ
             }
 
             if constexpr (int64_opt == utils::Int64_R_Type::String) {
-                return build_vector_mixed<STRSXP>(array);					// #nocov
+                return build_vector_mixed<STRSXP>(array, parse_opts.string_cache);	// #nocov
             }
 
             if constexpr (int64_opt == utils::Int64_R_Type::Integer64 ||
@@ -143,7 +198,7 @@ inline SEXP dispatch_mixed(simdjson::dom::array array, const rcpp_T common_R_typ
             return build_vector_mixed<INTSXP>(array);
 
         case rcpp_T::u64:
-            return build_vector_mixed<STRSXP>(array);
+            return build_vector_mixed<STRSXP>(array, parse_opts.string_cache);
 
             // # nocov start
         case rcpp_T::lgl:
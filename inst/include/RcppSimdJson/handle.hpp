@@ -0,0 +1,74 @@
+#ifndef RCPPSIMDJSON__HANDLE_HPP
+#define RCPPSIMDJSON__HANDLE_HPP
+
+
+#include "ndjson.hpp"
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief A parsed document kept alive between R calls (see `fparse_handle()`).
+ *
+ * `root` points into `parser`'s tape and string buffers, so the two live and die together and a
+ * handle must never be copied or moved once parsed.
+ */
+struct Document_Handle {
+    simdjson::dom::parser  parser;
+    simdjson::dom::element root;
+};
+
+
+/**
+ * @brief Parse `json` (a `character` (first element) or `raw` vector) into a new Document_Handle
+ * owned by an external pointer of class `"simdjson_document"`.
+ */
+inline SEXP parse_handle(SEXP json) {
+    auto handle = Rcpp::XPtr<Document_Handle>(new Document_Handle());
+
+    auto error = simdjson::SUCCESS;
+    if (TYPEOF(json) == RAWSXP) {
+        error = parse<Rcpp::RawVector, IS_NOT_FILE>(handle->parser, Rcpp::RawVector(json))
+                    .get(handle->root);
+    } else {
+        const auto json_chr = Rcpp::CharacterVector(json);
+        if (utils::is_na_string(json_chr[0])) {
+            Rcpp::stop("`json=` must not be `NA`.");
+        }
+        error = parse<Rcpp::CharacterVector, IS_NOT_FILE>(handle->parser, json_chr)
+                    .get(handle->root);
+    }
+
+    if (error != simdjson::SUCCESS) {
+        Rcpp::stop(simdjson::error_message(error));
+    }
+
+    handle.attr("class") = "simdjson_document";
+    return handle;
+}
+
+
+/**
+ * @brief Apply `query` to a Document_Handle's retained element, without reparsing.
+ *
+ * `query` is `NULL` (deserialize the entire document) or a `character` vector, following the same
+ * rules as `query_and_deserialize_document()`.
+ */
+template <bool query_error_ok>
+inline SEXP query_handle(SEXP              handle_ptr,
+                         SEXP              query,
+                         SEXP              on_query_error,
+                         const Parse_Opts& parse_opts) {
+    const auto handle = Rcpp::XPtr<Document_Handle>(handle_ptr).checked_get();
+    return query_and_deserialize_document<query_error_ok>(
+        handle->root, query, on_query_error, parse_opts);
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
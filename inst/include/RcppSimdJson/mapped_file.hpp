@@ -0,0 +1,133 @@
+#ifndef RCPPSIMDJSON__MAPPED_FILE_HPP
+#define RCPPSIMDJSON__MAPPED_FILE_HPP
+
+
+#include "common.hpp"
+
+#include <string> /* std::string */
+
+#if !defined(_WIN32)
+#    define RCPPSIMDJSON_HAVE_MMAP 1
+#    include <fcntl.h>    /* open */
+#    include <sys/mman.h> /* mmap, munmap, madvise */
+#    include <sys/stat.h> /* fstat */
+#    include <unistd.h>   /* close, sysconf */
+#endif
+
+
+namespace rcppsimdjson {
+namespace utils {
+
+
+/**
+ * @brief Whether `Mapped_File` can map files on this platform (otherwise files are always read).
+ */
+inline constexpr bool has_mmap() noexcept {
+#ifdef RCPPSIMDJSON_HAVE_MMAP
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+/**
+ * @brief A read-only, private memory mapping of an entire file, followed by at least
+ * simdjson::SIMDJSON_PADDING readable zero bytes, so it can be parsed in place.
+ *
+ * The kernel zero-fills the rest of the file's last page. When that leaves too little room for the
+ * padding, the file is mapped over an anonymous (zero) mapping one page longer instead, so no byte
+ * of the file is ever copied. Only the pages simdjson touches are ever resident, and they can be
+ * dropped under memory pressure since they are backed by the file itself.
+ *
+ * The file must not be truncated while it is mapped (reading a page past its new end raises
+ * SIGBUS), which is why mapping is opt-in.
+ */
+class Mapped_File {
+    const char* data_   = nullptr;
+    std::size_t size_   = 0;
+    std::size_t length_ = 0; /* the entire mapping, for munmap() */
+
+  public:
+    Mapped_File() = default;
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+
+    ~Mapped_File() {
+#ifdef RCPPSIMDJSON_HAVE_MMAP
+        if (length_ != 0) {
+            munmap(const_cast<char*>(data_), length_);
+        }
+#endif
+    }
+
+    [[nodiscard]] auto data() const noexcept -> const char* { return data_; }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+    /**
+     * @brief Map `file_path`. Does not touch the R API, so it is safe to call from worker threads.
+     *
+     * @return simdjson::IO_ERROR if the file can't be opened or mapped (or mapping is
+     * unavailable), otherwise simdjson::SUCCESS .
+     */
+    [[nodiscard]] auto map(const std::string& file_path) noexcept -> simdjson::error_code {
+#ifdef RCPPSIMDJSON_HAVE_MMAP
+        const int fd = open(file_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return simdjson::IO_ERROR;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            close(fd);
+            return simdjson::IO_ERROR;
+        }
+
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ == 0) { /* nothing to map, but simdjson still wants a padded pointer */
+            static const char empty[simdjson::SIMDJSON_PADDING] = {};
+            close(fd);
+            data_ = empty;
+            return simdjson::SUCCESS;
+        }
+
+        const auto page       = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const auto file_pages = (size_ + page - 1) / page * page;
+
+        void* addr = nullptr;
+        if (file_pages - size_ >= simdjson::SIMDJSON_PADDING) {
+            length_ = file_pages;
+            addr    = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        } else {
+            length_ = file_pages + page;
+            addr    = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (addr != MAP_FAILED) {
+                if (mmap(addr, size_, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                    munmap(addr, length_);
+                    addr = MAP_FAILED;
+                }
+            }
+        }
+        close(fd); /* the mapping keeps its own reference to the file */
+
+        if (addr == MAP_FAILED) {
+            size_ = length_ = 0;
+            return simdjson::IO_ERROR;
+        }
+#    ifdef MADV_SEQUENTIAL
+        madvise(addr, length_, MADV_SEQUENTIAL); /* stage 1 reads the file front to back */
+#    endif
+        data_ = static_cast<const char*>(addr);
+        return simdjson::SUCCESS;
+#else
+        static_cast<void>(file_path);
+        return simdjson::IO_ERROR;
+#endif
+    }
+};
+
+
+} // namespace utils
+} // namespace rcppsimdjson
+
+
+#endif
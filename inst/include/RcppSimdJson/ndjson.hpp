@@ -0,0 +1,215 @@
+#ifndef RCPPSIMDJSON__NDJSON_HPP
+#define RCPPSIMDJSON__NDJSON_HPP
+
+
+#include "deserialize.hpp"
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief Deserialize a single document of a stream, applying a flat `query` (if any).
+ *
+ * `query` is either `NULL` or a `character` vector; when the latter has more than one element,
+ * each document yields a (named) list with one element per query.
+ */
+template <bool query_error_ok>
+inline SEXP query_and_deserialize_document(simdjson::dom::element parsed,
+                                           SEXP                   query,
+                                           SEXP                   on_query_error,
+                                           const Parse_Opts&      parse_opts) {
+    if (TYPEOF(query) == NILSXP) {
+        return deserialize(parsed, parse_opts);
+    }
+
+    const Rcpp::CharacterVector queries(query);
+    if (std::size(queries) == 1) {
+        return query_and_deserialize<query_error_ok>(
+            parsed, queries[0], on_query_error, parse_opts);
+    }
+
+    return query_all_and_deserialize<query_error_ok>(parsed, queries, on_query_error, parse_opts);
+}
+
+
+/**
+ * @brief Deserialize every document of a `simdjson::dom::document_stream`.
+ *
+ * The stream is consumed in a single pass: simdjson's stage 1 runs ahead over the next batch (in
+ * a worker thread when `SIMDJSON_THREADS_ENABLED`) while each document is deserialized here.
+ *
+ * A stream cannot resume after a malformed document, so a parse error anywhere in the stream
+ * either throws or, if `parse_error_ok`, makes the entire result `on_parse_error`.
+ */
+template <bool parse_error_ok, bool query_error_ok>
+inline SEXP deserialize_stream(simdjson::simdjson_result<simdjson::dom::document_stream>&& result,
+                               SEXP              query,
+                               SEXP              on_parse_error,
+                               SEXP              on_query_error,
+                               const Parse_Opts& parse_opts) {
+    simdjson::dom::document_stream stream;
+    if (auto error = std::move(result).get(stream); error != simdjson::SUCCESS) {
+        if constexpr (parse_error_ok) {
+            return on_parse_error;
+        } else {
+            Rcpp::stop(simdjson::error_message(error));
+        }
+    }
+
+    std::vector<Rcpp::RObject> out;
+    for (auto it = stream.begin(); it != stream.end(); ++it) {
+        simdjson::dom::element parsed;
+        if (auto error = (*it).get(parsed); error != simdjson::SUCCESS) {
+            if constexpr (parse_error_ok) {
+                return on_parse_error;
+            } else {
+                Rcpp::stop(simdjson::error_message(error));
+            }
+        }
+        out.emplace_back(query_and_deserialize_document<query_error_ok>(
+            parsed, query, on_query_error, parse_opts));
+    }
+
+    /* an unterminated trailing document ends the stream quietly, but it's still malformed */
+    if (stream.truncated_bytes() != 0) {
+        if constexpr (parse_error_ok) {
+            return on_parse_error;
+        } else {
+            Rcpp::stop(simdjson::error_message(simdjson::INCOMPLETE_ARRAY_OR_OBJECT));
+        }
+    }
+
+    return Rcpp::List(std::begin(out), std::end(out));
+}
+
+
+/**
+ * @brief Start a `simdjson::dom::document_stream` over NDJSON input.
+ *
+ * If `is_file`, `json` is a file path, which is handed to `parser.load_many()` (or memory-mapped,
+ * if `parse_opts.use_mmap`) unless it is `memDecompress()`-compressed, in which case it is
+ * decompressed straight into a padded buffer.
+ * Otherwise, `json` is a `character` (first element) or `raw` vector holding the entire NDJSON
+ * buffer, which is streamed in place when its padding is readable (see `utils::json_buffer()`)
+ * and otherwise copied once into a padded buffer.
+ */
+template <bool is_file, bool parse_error_ok, bool query_error_ok>
+inline SEXP parse_many_and_deserialize(SEXP              json,
+                                       SEXP              query,
+                                       SEXP              on_parse_error,
+                                       SEXP              on_query_error,
+                                       const Parse_Opts& parse_opts) {
+    simdjson::dom::parser parser;
+    utils::Json_Buffer    input;
+
+    if (TYPEOF(json) == RAWSXP) {
+        input = utils::json_buffer(json);
+
+    } else {
+        const auto json_chr = Rcpp::CharacterVector(json)[0];
+        if (utils::is_na_string(json_chr)) {
+            return Rcpp::LogicalVector(1, NA_LOGICAL);
+        }
+
+        if constexpr (is_file) {
+            const auto file_type = utils::get_memDecompress_type(std::string_view(json_chr));
+            if (!file_type && parse_opts.use_mmap && utils::has_mmap()) {
+                utils::Mapped_File mapped;
+                if (const auto error = mapped.map(std::string(json_chr)); error) {
+                    return deserialize_stream<parse_error_ok, query_error_ok>(
+                        error, query, on_parse_error, on_query_error, parse_opts);
+                }
+                return deserialize_stream<parse_error_ok, query_error_ok>(
+                    parser.parse_many(
+                        mapped.data(), mapped.size(), simdjson::dom::DEFAULT_BATCH_SIZE),
+                    query,
+                    on_parse_error,
+                    on_query_error,
+                    parse_opts);
+            }
+            if (!file_type) {
+                return deserialize_stream<parse_error_ok, query_error_ok>(
+                    parser.load_many(std::string(json_chr)),
+                    query,
+                    on_parse_error,
+                    on_query_error,
+                    parse_opts);
+            }
+            /* the decompressed buffer is already padded, so it is streamed without a copy */
+            const auto decompressed = utils::decompress_padded(std::string(json_chr), *file_type);
+            return deserialize_stream<parse_error_ok, query_error_ok>(
+                parser.parse_many(decompressed.data(),
+                                  decompressed.size(),
+                                  simdjson::dom::DEFAULT_BATCH_SIZE),
+                query,
+                on_parse_error,
+                on_query_error,
+                parse_opts);
+
+        } else {
+            input = utils::json_buffer(std::string_view(json_chr));
+        }
+    }
+
+    if (!input.realloc_if_needed) {
+        return deserialize_stream<parse_error_ok, query_error_ok>(
+            parser.parse_many(
+                input.json.data(), std::size(input.json), simdjson::dom::DEFAULT_BATCH_SIZE),
+            query,
+            on_parse_error,
+            on_query_error,
+            parse_opts);
+    }
+
+    const auto buffer = simdjson::padded_string(input.json);
+    return deserialize_stream<parse_error_ok, query_error_ok>(
+        parser.parse_many(buffer), query, on_parse_error, on_query_error, parse_opts);
+}
+
+
+template <bool is_file>
+inline SEXP start_ndjson(SEXP       json,
+                         SEXP       query,
+                         SEXP       empty_array,
+                         SEXP       empty_object,
+                         SEXP       single_null,
+                         const bool parse_error_ok,
+                         SEXP       on_parse_error,
+                         const bool query_error_ok,
+                         SEXP       on_query_error,
+                         const int  simplify_to,
+                         const int  type_policy,
+                         const int  int64_r_type,
+                         const bool use_mmap = false) {
+    const auto parse_opts = Parse_Opts{static_cast<Simplify_To>(simplify_to),
+                                       static_cast<Type_Policy>(type_policy),
+                                       static_cast<utils::Int64_R_Type>(int64_r_type),
+                                       empty_array,
+                                       empty_object,
+                                       single_null,
+                                       1,
+                                       use_mmap};
+
+    if (parse_error_ok) {
+        return query_error_ok
+                   ? parse_many_and_deserialize<is_file, PARSE_ERROR_OK, QUERY_ERROR_OK>(
+                         json, query, on_parse_error, on_query_error, parse_opts)
+                   : parse_many_and_deserialize<is_file, PARSE_ERROR_OK, QUERY_ERROR_NOT_OK>(
+                         json, query, on_parse_error, on_query_error, parse_opts);
+    } else { /* !parse_error_ok */
+        return query_error_ok
+                   ? parse_many_and_deserialize<is_file, PARSE_ERROR_NOT_OK, QUERY_ERROR_OK>(
+                         json, query, on_parse_error, on_query_error, parse_opts)
+                   : parse_many_and_deserialize<is_file, PARSE_ERROR_NOT_OK, QUERY_ERROR_NOT_OK>(
+                         json, query, on_parse_error, on_query_error, parse_opts);
+    }
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
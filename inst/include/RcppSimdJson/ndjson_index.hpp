@@ -0,0 +1,172 @@
+#ifndef RCPPSIMDJSON__NDJSON_INDEX_HPP
+#define RCPPSIMDJSON__NDJSON_INDEX_HPP
+
+
+#include "mapped_file.hpp"
+#include "ndjson_reader.hpp"
+
+#include <algorithm>   /* std::all_of */
+#include <cmath>       /* std::trunc */
+#include <cstdio>      /* std::FILE, std::fopen, std::fread */
+#include <cstring>     /* std::memchr */
+#include <memory>      /* std::unique_ptr */
+#include <string>      /* std::string */
+#include <string_view> /* std::string_view */
+#include <tuple>       /* std::tuple */
+#include <vector>      /* std::vector */
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief The byte offsets at which the documents of an NDJSON file start, gathered as the file is
+ * scanned block by block.
+ *
+ * Newlines are found with `std::memchr()`, which every libc vectorizes, and blank lines aren't
+ * documents. Document `i` (0-based) lies within `[offsets[i], offsets[i + 1])`, the last one
+ * ending with the file (whose size is the offsets' `"size"` attribute).
+ */
+class Ndjson_Indexer {
+    std::vector<double> offsets_;
+    double              size_       = 0; /* of what was scanned so far */
+    double              line_start_ = 0;
+    bool                is_blank_   = true; /* so far, the current line */
+
+    static auto is_blank(const char* begin, const char* end) noexcept -> bool {
+        return std::all_of(begin, end, [](const char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        });
+    }
+
+  public:
+    void scan(const char* data, const std::size_t size) {
+        const auto* const end = data + size;
+        for (const auto* line = data; line < end;) {
+            const auto  rest    = static_cast<std::size_t>(end - line);
+            const auto* newline = static_cast<const char*>(std::memchr(line, '\n', rest));
+            is_blank_ = is_blank_ && is_blank(line, newline ? newline : end);
+            if (!newline) {
+                break;
+            }
+            if (!is_blank_) {
+                offsets_.push_back(line_start_);
+            }
+            line_start_ = size_ + static_cast<double>(newline + 1 - data);
+            is_blank_   = true;
+            line        = newline + 1;
+        }
+        size_ += static_cast<double>(size);
+    }
+
+    auto finish() -> Rcpp::NumericVector {
+        if (!is_blank_) {
+            offsets_.push_back(line_start_); /* an unterminated last line */
+        }
+        auto out         = Rcpp::NumericVector(std::begin(offsets_), std::end(offsets_));
+        out.attr("size") = size_;
+        return out;
+    }
+};
+
+
+/**
+ * @brief Index the documents of the NDJSON file at `path` (see `Ndjson_Indexer`), mapping the file
+ * if possible and otherwise reading it in blocks.
+ */
+inline auto index_ndjson(const std::string& path) -> Rcpp::NumericVector {
+    auto indexer = Ndjson_Indexer();
+
+    if (utils::Mapped_File mapped; mapped.map(path) == simdjson::SUCCESS) {
+        indexer.scan(mapped.data(), mapped.size());
+        return indexer.finish();
+    }
+
+    const auto file = std::unique_ptr<std::FILE, File_Closer>(std::fopen(path.c_str(), "rb"));
+    if (!file) {
+        Rcpp::stop("Can't open '" + path + "'.");
+    }
+    auto block = std::vector<char>(1 << 20);
+    while (const auto size = std::fread(block.data(), 1, std::size(block), file.get())) {
+        indexer.scan(block.data(), size);
+    }
+    if (std::ferror(file.get())) {
+        Rcpp::stop("Can't read '" + path + "'.");
+    }
+    return indexer.finish();
+}
+
+
+/**
+ * @brief Deserialize the documents `rows` (1-based, in that order) of the NDJSON file at `path`,
+ * located with its `offsets` and `size` (see `index_ndjson()`), as a single array of documents.
+ *
+ * Only the requested documents are read (and parsed): the file is mapped if possible and
+ * otherwise read with a seek per document.
+ */
+inline SEXP load_ndjson_rows(const std::string&         path,
+                             const Rcpp::NumericVector& offsets,
+                             const double               size,
+                             const Rcpp::NumericVector& rows,
+                             const Parse_Opts&          parse_opts) {
+    const auto n_docs = static_cast<R_xlen_t>(std::size(offsets));
+
+    /* the 0-based index of `row`, and its document's offset and length */
+    const auto locate = [&offsets, size, n_docs](const double row) {
+        if (row != std::trunc(row)) { /* NaN included */
+            Rcpp::stop("`rows` must be whole numbers.");
+        }
+        if (!(row >= 1 && row <= static_cast<double>(n_docs))) {
+            Rcpp::stop("`rows` must be between 1 and the number of rows (" +
+                       std::to_string(n_docs) + ").");
+        }
+        const auto i   = static_cast<R_xlen_t>(row) - 1;
+        const auto end = i + 1 < n_docs ? offsets[i + 1] : size;
+        return std::tuple(i, offsets[i], static_cast<std::size_t>(end - offsets[i]));
+    };
+
+    auto chunk = Ndjson_Chunk();
+
+    if (utils::Mapped_File mapped; mapped.map(path) == simdjson::SUCCESS) {
+        if (static_cast<double>(mapped.size()) != size) {
+            Rcpp::stop("'" + path + "' has changed since it was indexed.");
+        }
+        for (const auto row : rows) {
+            const auto [i, offset, length] = locate(row);
+            const auto* document = mapped.data() + static_cast<std::size_t>(offset);
+            chunk.add_line(std::string_view(document, length));
+        }
+
+    } else {
+        const auto file = std::unique_ptr<std::FILE, File_Closer>(std::fopen(path.c_str(), "rb"));
+        if (!file) {
+            Rcpp::stop("Can't open '" + path + "'.");
+        }
+        auto line = std::string();
+        for (const auto row : rows) {
+            const auto [i, offset, length] = locate(row);
+            line.resize(length);
+            if (!seek_file(file.get(), offset) ||
+                std::fread(line.data(), 1, std::size(line), file.get()) != std::size(line)) {
+                Rcpp::stop("Can't read row " + std::to_string(i + 1) + " of '" + path +
+                           "'; has it changed since it was indexed?");
+            }
+            chunk.add_line(line);
+        }
+    }
+
+    if (chunk.n_docs() != static_cast<R_xlen_t>(std::size(rows))) {
+        Rcpp::stop("'" + path + "' has changed since it was indexed (a requested row is blank).");
+    }
+
+    simdjson::dom::parser parser;
+    return chunk.deserialize(parser, parse_opts, [&rows](const R_xlen_t i) { return rows[i]; });
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
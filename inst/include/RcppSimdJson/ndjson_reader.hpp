@@ -0,0 +1,733 @@
+#ifndef RCPPSIMDJSON__NDJSON_READER_HPP
+#define RCPPSIMDJSON__NDJSON_READER_HPP
+
+
+#include "deserialize.hpp"
+
+#include <algorithm>   /* std::all_of, std::sort, std::binary_search */
+#include <cstddef>     /* std::ptrdiff_t */
+#include <cstdio>      /* std::FILE, std::fopen, std::fread */
+#include <cstring>     /* std::memchr */
+#include <memory>      /* std::unique_ptr */
+#include <string>      /* std::string */
+#include <string_view> /* std::string_view */
+#include <utility>     /* std::pair */
+#include <vector>      /* std::vector */
+
+#include <sys/stat.h>  /* stat, fstat */
+#include <sys/types.h> /* off_t */
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+struct File_Closer {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+
+
+/* `std::fseek()` takes a `long`, which can't reach past 2 GB on Windows */
+inline auto seek_file(std::FILE* file, const double offset) noexcept -> bool {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+
+/**
+ * @brief NDJSON lines gathered into a single JSON array (`[line,line,...]`), so that a chunk of
+ * documents is parsed once and simplified together (e.g. to a data frame) like any other array.
+ *
+ * Lines are appended in pieces (see `open_line()`, `append()` and `close_line()`), and blank lines
+ * are dropped. The buffer keeps its capacity between chunks.
+ *
+ * Joining lines would let a document span several of them (`[1` then `2]`), so each line is also
+ * scanned for balanced brackets outside of strings as it's closed: if every line is balanced, the
+ * array parses, and it has a single element per line, each line is exactly one JSON document.
+ * Otherwise, each line is parsed on its own to tell which aren't (see `deserialize()`).
+ */
+class Ndjson_Chunk {
+    std::string              buffer_     = std::string("[");
+    std::size_t              line_start_ = 0; /* where the current line's separator starts */
+    std::vector<std::size_t> doc_starts_;     /* where each document starts, past its separator */
+    R_xlen_t                 n_unbalanced_ = 0;
+
+    static auto is_blank(const char* begin, const char* end) noexcept -> bool {
+        return std::all_of(begin, end, [](const char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        });
+    }
+
+    /* whether every bracket opened between `begin` and `end` is closed there, strings aside */
+    static auto is_balanced(const char* begin, const char* end) noexcept -> bool {
+        auto depth     = std::ptrdiff_t(0);
+        auto in_string = false;
+        for (const auto* c = begin; c < end; ++c) {
+            if (in_string) {
+                if (*c == '\\') {
+                    ++c; /* the escaped character */
+                } else if (*c == '"') {
+                    in_string = false;
+                }
+                continue;
+            }
+            switch (*c) {
+                case '"':
+                    in_string = true;
+                    break;
+                case '[':
+                case '{':
+                    ++depth;
+                    break;
+                case ']':
+                case '}':
+                    if (--depth < 0) {
+                        return false;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        return depth == 0 && !in_string;
+    }
+
+    [[nodiscard]] auto doc(const R_xlen_t i) const noexcept -> std::string_view {
+        const auto begin = doc_starts_[static_cast<std::size_t>(i)];
+        const auto end   = i + 1 < n_docs() ? doc_starts_[static_cast<std::size_t>(i) + 1] - 1
+                                            : std::size(buffer_);
+        return std::string_view(buffer_).substr(begin, end - begin);
+    }
+
+    /* the chunk's documents, unless a line isn't exactly one document */
+    auto parse(simdjson::dom::parser& parser, simdjson::dom::array& array) -> simdjson::error_code {
+        if (n_unbalanced_ > 0) {
+            return simdjson::TAPE_ERROR;
+        }
+        buffer_.push_back(']');
+        /* std::string overload: only copied if the capacity can't hold simdjson's padding */
+        buffer_.reserve(std::size(buffer_) + simdjson::SIMDJSON_PADDING);
+        const auto error = parser.parse(buffer_).get(array);
+        buffer_.pop_back(); /* the parser has its own copy, or the padding is past the end */
+        if (error) {
+            return error;
+        }
+        return static_cast<R_xlen_t>(std::size(array)) == n_docs() ? simdjson::SUCCESS
+                                                                  : simdjson::TAPE_ERROR;
+    }
+
+    /* the (0-based) index of each line that doesn't parse on its own, and why */
+    auto bad_lines(simdjson::dom::parser& parser) const
+        -> std::vector<std::pair<R_xlen_t, simdjson::error_code>> {
+        auto out = std::vector<std::pair<R_xlen_t, simdjson::error_code>>();
+        for (R_xlen_t i = 0; i < n_docs(); ++i) {
+            const auto line = doc(i);
+            if (const auto error = parser.parse(std::data(line), std::size(line)).error()) {
+                out.emplace_back(i, error);
+            }
+        }
+        return out;
+    }
+
+    /* replace the documents `i_docs` (in order) with `placeholder` */
+    void replace(const std::vector<std::pair<R_xlen_t, simdjson::error_code>>& i_docs,
+                 const std::string_view                                       placeholder) {
+        auto buffer  = std::string("[");
+        auto starts  = std::vector<std::size_t>();
+        auto i_bad   = std::size_t(0);
+        buffer.reserve(std::size(buffer_));
+        starts.reserve(std::size(doc_starts_));
+        for (R_xlen_t i = 0; i < n_docs(); ++i) {
+            if (i > 0) {
+                buffer.push_back(',');
+            }
+            starts.push_back(std::size(buffer));
+            if (i_bad < std::size(i_docs) && i_docs[i_bad].first == i) {
+                buffer.append(placeholder);
+                ++i_bad;
+            } else {
+                buffer.append(doc(i));
+            }
+        }
+        buffer_.swap(buffer);
+        doc_starts_.swap(starts);
+        n_unbalanced_ = 0; /* what's left parses on its own */
+    }
+
+    /* what replaces bad lines: `{}` (a row of `NA`s) among records, `null` otherwise */
+    [[nodiscard]] auto placeholder(
+        const std::vector<std::pair<R_xlen_t, simdjson::error_code>>& bad) const noexcept
+        -> std::string_view {
+        auto i_bad = std::size_t(0);
+        for (R_xlen_t i = 0; i < n_docs(); ++i) {
+            if (i_bad < std::size(bad) && bad[i_bad].first == i) {
+                ++i_bad;
+                continue;
+            }
+            const auto line = doc(i);
+            return line[line.find_first_not_of(" \t\r\n")] == '{' ? "{}" : "null";
+        }
+        return "null";
+    }
+
+  public:
+    [[nodiscard]] auto n_docs() const noexcept -> R_xlen_t {
+        return static_cast<R_xlen_t>(std::size(doc_starts_));
+    }
+    [[nodiscard]] auto n_bytes() const noexcept -> std::size_t { return std::size(buffer_) - 1; }
+
+    void open_line() {
+        line_start_ = std::size(buffer_);
+        if (n_docs() > 0) {
+            buffer_.push_back(',');
+        }
+    }
+
+    void append(const char* data, const std::size_t size) { buffer_.append(data, size); }
+
+    /* whether the line was a document rather than blank */
+    auto close_line() -> bool {
+        const auto  doc_start = line_start_ + (n_docs() > 0 ? 1 : 0);
+        const auto* begin     = buffer_.data() + doc_start;
+        const auto* end       = buffer_.data() + std::size(buffer_);
+        if (is_blank(begin, end)) {
+            buffer_.resize(line_start_);
+            return false;
+        }
+        doc_starts_.push_back(doc_start);
+        n_unbalanced_ += is_balanced(begin, end) ? 0 : 1;
+        return true;
+    }
+
+    void add_line(const std::string_view line) {
+        open_line();
+        append(std::data(line), std::size(line));
+        close_line();
+    }
+
+    /* drop the last document, e.g. one already known not to parse */
+    void drop_last() {
+        const auto line = doc(n_docs() - 1);
+        n_unbalanced_ -= is_balanced(std::data(line), std::data(line) + std::size(line)) ? 0 : 1;
+        buffer_.resize(doc_starts_.back() - (n_docs() > 1 ? 1 : 0));
+        doc_starts_.pop_back();
+    }
+
+    void clear() {
+        buffer_.resize(1);
+        doc_starts_.clear();
+        n_unbalanced_ = 0;
+    }
+
+    /**
+     * @brief Parse the chunk with `parser` and deserialize it as an array of its documents.
+     *
+     * A line that isn't exactly one JSON document is an error naming its row, unless
+     * `parse_error_ok`: it's then deserialized as a missing row (see `placeholder()`) and listed,
+     * with simdjson's error, in the `"parse_errors"` attribute of the result (a `character` vector
+     * named by row).
+     *
+     * @param row_of Returns the (1-based) row of the chunk's `i`-th document, for error messages.
+     * @param bad_rows If not `nullptr`, where the rows of lines that aren't a JSON document are
+     * added before the error is raised, so that they can be skipped when the chunk is read again.
+     */
+    template <typename Row_Of>
+    auto deserialize(simdjson::dom::parser& parser,
+                     const Parse_Opts&      parse_opts,
+                     Row_Of&&               row_of,
+                     const bool             parse_error_ok = false,
+                     std::vector<double>*   bad_rows       = nullptr) -> SEXP {
+        const auto to_string = [](const double row) {
+            return std::to_string(static_cast<long long>(row));
+        };
+
+        simdjson::dom::array array;
+        const auto           error = parse(parser, array);
+        if (!error) {
+            return rcppsimdjson::deserialize::deserialize(array, parse_opts);
+        }
+
+        const auto bad = bad_lines(parser);
+        if (std::empty(bad)) { /* each line parses, but not all of them at once */
+            Rcpp::stop(simdjson::error_message(error) + std::string(" (rows ") +
+                       to_string(row_of(0)) + " to " + to_string(row_of(n_docs() - 1)) + ")");
+        }
+        if (!parse_error_ok) {
+            if (bad_rows) {
+                for (const auto& [i, _] : bad) {
+                    bad_rows->push_back(row_of(i));
+                }
+            }
+            const auto n_more = std::size(bad) - 1;
+            Rcpp::stop("Row " + to_string(row_of(bad.front().first)) +
+                       " isn't a single JSON document: " +
+                       simdjson::error_message(bad.front().second) +
+                       (n_more > 0 ? " (and " + std::to_string(n_more) + " more rows)" : ""));
+        }
+
+        auto errors = Rcpp::CharacterVector(std::size(bad));
+        auto rows   = Rcpp::CharacterVector(std::size(bad));
+        for (std::size_t j = 0; j < std::size(bad); ++j) {
+            errors[j] = simdjson::error_message(bad[j].second);
+            rows[j]   = to_string(row_of(bad[j].first));
+        }
+        errors.attr("names") = rows;
+
+        replace(bad, placeholder(bad));
+        if (const auto retry = parse(parser, array)) {
+            Rcpp::stop(simdjson::error_message(retry) + std::string(" (rows ") +
+                       to_string(row_of(0)) + " to " + to_string(row_of(n_docs() - 1)) + ")");
+        }
+        auto out                 = Rcpp::RObject(rcppsimdjson::deserialize::deserialize(array,
+                                                                             parse_opts));
+        out.attr("parse_errors") = errors;
+        return out;
+    }
+};
+
+
+/**
+ * @brief The rows of lines found not to be a JSON document in a chunk that was then read again
+ * (see `Ndjson_Chunk::deserialize()`), so that they're skipped the second time: each such line is
+ * reported once, and the next call returns the documents around it.
+ *
+ * Rows are 1-based and counted from the start of the file (or of following it), skipped ones
+ * included.
+ */
+class Skipped_Rows {
+    std::vector<double> rows_; /* sorted */
+
+  public:
+    void add(const std::vector<double>& rows) {
+        rows_.insert(std::end(rows_), std::begin(rows), std::end(rows));
+        std::sort(std::begin(rows_), std::end(rows_));
+        rows_.erase(std::unique(std::begin(rows_), std::end(rows_)), std::end(rows_));
+    }
+
+    [[nodiscard]] auto contains(const double row) const noexcept -> bool {
+        return std::binary_search(std::begin(rows_), std::end(rows_), row);
+    }
+
+    /* the row of a chunk's `i`-th document, the chunk starting at `first_row` */
+    [[nodiscard]] auto row_of(const double first_row, const R_xlen_t i) const noexcept -> double {
+        auto row = first_row + static_cast<double>(i);
+        for (const auto skipped : rows_) {
+            if (skipped >= first_row && skipped <= row) {
+                ++row;
+            }
+        }
+        return row;
+    }
+
+    /* forget the rows up to `row`, once they've been read for good */
+    void forget_through(const double row) {
+        rows_.erase(std::begin(rows_), std::upper_bound(std::begin(rows_), std::end(rows_), row));
+    }
+};
+
+
+/**
+ * @brief A file cursor and parser kept alive between R calls (see `ndjson_reader()`), so that an
+ * NDJSON file is deserialized `chunk_rows` documents at a time and memory peaks at a chunk.
+ *
+ * The file is read in blocks through a fixed buffer; a line straddling two blocks is carried over
+ * in the chunk being built.
+ */
+class Ndjson_Reader {
+    static constexpr std::size_t BLOCK_SIZE = 1 << 20;
+
+    std::string                             path_;
+    std::unique_ptr<std::FILE, File_Closer> file_;
+    std::vector<char>                       block_ = std::vector<char>(BLOCK_SIZE);
+    std::size_t                             block_pos_ = 0;
+    std::size_t                             block_end_ = 0;
+    Ndjson_Chunk                            chunk_;
+    simdjson::dom::parser                   parser_;
+    Skipped_Rows                            skipped_;
+    double                                  n_rows_    = 0; /* skipped ones included */
+    double                                  n_skipped_ = 0; /* in the chunk being read */
+    double                                  n_bytes_   = 0;
+    bool                                    is_done_   = false;
+
+    /* the next block, if any is left */
+    auto fill() -> bool {
+        block_pos_ = 0;
+        block_end_ = std::fread(block_.data(), 1, std::size(block_), file_.get());
+        n_bytes_ += static_cast<double>(block_end_);
+        if (block_end_ == 0 && std::ferror(file_.get())) {
+            Rcpp::stop("Can't read '" + path_ + "'.");
+        }
+        return block_end_ > 0;
+    }
+
+    /* add the next line to `chunk_` (unless skipped), returning `false` once the file is done */
+    auto read_line() -> bool {
+        if (block_pos_ == block_end_ && !fill()) {
+            return false;
+        }
+
+        chunk_.open_line();
+        for (;;) {
+            const auto* const begin = block_.data() + block_pos_;
+            const auto        size  = block_end_ - block_pos_;
+            if (const auto* newline = static_cast<const char*>(std::memchr(begin, '\n', size))) {
+                chunk_.append(begin, static_cast<std::size_t>(newline - begin));
+                block_pos_ += static_cast<std::size_t>(newline - begin) + 1;
+                break;
+            }
+            chunk_.append(begin, size);
+            if (!fill()) {
+                break; /* an unterminated last line */
+            }
+        }
+        if (chunk_.close_line() &&
+            skipped_.contains(n_rows_ + static_cast<double>(chunk_.n_docs()) + n_skipped_)) {
+            chunk_.drop_last();
+            ++n_skipped_;
+        }
+
+        return true;
+    }
+
+    /* where the next line starts: what was read, less what's left of the block */
+    auto consumed() const noexcept -> double {
+        return n_bytes_ - static_cast<double>(block_end_ - block_pos_);
+    }
+
+    /* read again from `offset`, e.g. where a chunk that failed to deserialize started */
+    void rewind_to(const double offset) {
+        if (!seek_file(file_.get(), offset)) {
+            Rcpp::stop("Can't seek in '" + path_ + "'.");
+        }
+        block_pos_ = block_end_ = 0;
+        n_bytes_                = offset;
+    }
+
+  public:
+    explicit Ndjson_Reader(std::string path)
+        : path_(std::move(path)), file_(std::fopen(path_.c_str(), "rb")) {
+        if (!file_) {
+            Rcpp::stop("Can't open '" + path_ + "'.");
+        }
+    }
+
+    Ndjson_Reader(const Ndjson_Reader&) = delete;
+    Ndjson_Reader& operator=(const Ndjson_Reader&) = delete;
+
+    [[nodiscard]] auto path() const noexcept -> const std::string& { return path_; }
+    [[nodiscard]] auto n_rows() const noexcept -> double { return n_rows_; }
+    [[nodiscard]] auto n_bytes() const noexcept -> double { return n_bytes_; }
+    [[nodiscard]] auto is_done() const noexcept -> bool { return is_done_; }
+
+    /**
+     * @brief Deserialize the next (at most) `chunk_rows` documents, or return `NULL` once there
+     * are none left.
+     *
+     * The cursor only moves past the chunk once it is deserialized: if that fails, the next call
+     * reads the same documents again, less the lines that failed to parse, which are skipped (see
+     * `Skipped_Rows`). With `parse_error_ok`, those are missing rows instead (see
+     * `Ndjson_Chunk::deserialize()`).
+     */
+    auto next_chunk(const R_xlen_t    chunk_rows,
+                    const Parse_Opts& parse_opts,
+                    const bool        parse_error_ok) -> SEXP {
+        chunk_.clear();
+        n_skipped_         = 0;
+        const auto start   = consumed();
+        auto       is_done = is_done_;
+        while (!is_done && chunk_.n_docs() < chunk_rows) {
+            is_done = !read_line();
+        }
+
+        SEXP out = R_NilValue;
+        if (chunk_.n_docs() > 0) {
+            const auto first_row = n_rows_ + 1;
+            const auto row_of    = [this, first_row](const R_xlen_t i) {
+                return skipped_.row_of(first_row, i);
+            };
+            auto bad_rows = std::vector<double>();
+            try {
+                out = chunk_.deserialize(parser_, parse_opts, row_of, parse_error_ok, &bad_rows);
+            } catch (...) {
+                skipped_.add(bad_rows);
+                rewind_to(start);
+                throw;
+            }
+        }
+        n_rows_ += static_cast<double>(chunk_.n_docs()) + n_skipped_;
+        skipped_.forget_through(n_rows_);
+        is_done_ = is_done;
+        if (is_done_) {
+            file_.reset(); /* nothing more to read */
+        }
+        return out;
+    }
+};
+
+
+/**
+ * @brief A cursor following an NDJSON file that is still being appended to (e.g. a log), kept
+ * alive between R calls (see `ndjson_follower()`), so that each call only parses the documents
+ * written since the previous one.
+ *
+ * Only complete (newline-terminated) lines are consumed: a trailing partial line is held back until
+ * the rest of it has been written. The file stays open between calls and is read sequentially, so
+ * nothing is read twice.
+ *
+ * Rotation is detected as `tail -F` does: once the open file is drained, if `path` names another
+ * file (another device or inode), that file is followed from its start; if the open file shrank
+ * below what was already read, it was truncated and is read again from its start. Windows has no
+ * inode numbers, so only truncation is detected there.
+ */
+class Ndjson_Follower {
+    static constexpr std::size_t BLOCK_SIZE = 1 << 16;
+
+#ifdef _WIN32
+    using File_Info = struct _stat64;
+    static auto stat_path(const std::string& path, File_Info& info) noexcept -> bool {
+        return _stat64(path.c_str(), &info) == 0;
+    }
+    static auto stat_file(std::FILE* file, File_Info& info) noexcept -> bool {
+        return _fstat64(_fileno(file), &info) == 0;
+    }
+#else
+    using File_Info = struct stat;
+    static auto stat_path(const std::string& path, File_Info& info) noexcept -> bool {
+        return stat(path.c_str(), &info) == 0;
+    }
+    static auto stat_file(std::FILE* file, File_Info& info) noexcept -> bool {
+        return fstat(fileno(file), &info) == 0;
+    }
+#endif
+
+    std::string                             path_;
+    std::unique_ptr<std::FILE, File_Closer> file_;
+    File_Info                               info_{}; /* of `file_`, for its device and inode */
+    std::vector<char>                       block_ = std::vector<char>(BLOCK_SIZE);
+    std::size_t                             block_pos_ = 0;
+    std::size_t                             block_end_ = 0;
+    std::string                             partial_;      /* the held back partial line */
+    double                                  offset_   = 0; /* the end of the last complete line */
+    double                                  read_pos_ = 0; /* where `file_` is at */
+    Ndjson_Chunk                            chunk_;
+    simdjson::dom::parser                   parser_;
+    Skipped_Rows                            skipped_;
+    double                                  n_rows_      = 0; /* skipped ones included */
+    double                                  n_skipped_   = 0; /* in the chunk being read */
+    double                                  n_rotations_ = 0;
+
+    /* where a call started, to go back to if its chunk fails to deserialize */
+    struct Cursor {
+        std::unique_ptr<std::FILE, File_Closer> file; /* the file rotated away from, if any */
+        File_Info                               info;
+        std::string                             partial;
+        double                                  offset;
+        double                                  n_rotations;
+    };
+
+    /* go back to `cursor`, reading its partial line again rather than keeping the block */
+    void rewind_to(Cursor& cursor) {
+        if (cursor.file) {
+            file_ = std::move(cursor.file);
+            info_ = cursor.info;
+        }
+        const auto read_pos = cursor.offset + static_cast<double>(std::size(cursor.partial));
+        if (!seek_file(file_.get(), read_pos)) {
+            Rcpp::stop("Can't seek in '" + path_ + "'.");
+        }
+        block_pos_ = block_end_ = 0;
+        partial_               = std::move(cursor.partial);
+        offset_                = cursor.offset;
+        read_pos_              = read_pos;
+        n_rotations_           = cursor.n_rotations;
+    }
+
+    /* forget everything read from `file_` and start over at `offset` */
+    void restart(const double offset) {
+        block_pos_ = block_end_ = 0;
+        partial_.clear();
+        offset_ = read_pos_ = offset;
+    }
+
+    /* add complete lines to `chunk_` until it's full, returning `false` once `file_` is drained */
+    auto read_lines(const R_xlen_t chunk_rows) -> bool {
+        while (chunk_.n_docs() < chunk_rows) {
+            if (block_pos_ == block_end_) {
+                std::clearerr(file_.get()); /* forget the last EOF, so appended data can be read */
+                block_pos_ = 0;
+                block_end_ = std::fread(block_.data(), 1, std::size(block_), file_.get());
+                read_pos_ += static_cast<double>(block_end_);
+                if (block_end_ == 0) {
+                    if (std::ferror(file_.get())) {
+                        Rcpp::stop("Can't read '" + path_ + "'.");
+                    }
+                    return false;
+                }
+            }
+
+            const auto* const begin = block_.data() + block_pos_;
+            const auto        size  = block_end_ - block_pos_;
+            const auto* newline     = static_cast<const char*>(std::memchr(begin, '\n', size));
+            if (!newline) {
+                partial_.append(begin, size);
+                block_pos_ = block_end_;
+                continue;
+            }
+
+            const auto line_size = static_cast<std::size_t>(newline - begin);
+            chunk_.open_line();
+            chunk_.append(std::data(partial_), std::size(partial_));
+            chunk_.append(begin, line_size);
+            if (chunk_.close_line() &&
+                skipped_.contains(n_rows_ + static_cast<double>(chunk_.n_docs()) + n_skipped_)) {
+                chunk_.drop_last();
+                ++n_skipped_;
+            }
+            offset_ += static_cast<double>(std::size(partial_) + line_size + 1);
+            partial_.clear();
+            block_pos_ += line_size + 1;
+        }
+        return true;
+    }
+
+    /* whether `file_` was truncated below what was already read from it */
+    auto is_truncated() const -> bool {
+        File_Info info;
+        return stat_file(file_.get(), info) && static_cast<double>(info.st_size) < read_pos_;
+    }
+
+    /**
+     * Whether `path_` now names another file than `file_`, which is then opened instead. The file
+     * first rotated away from is kept in `cursor`.
+     */
+    auto reopen_if_rotated(Cursor& cursor) -> bool {
+        File_Info info;
+        if (!stat_path(path_, info)) {
+            return false; /* none yet, e.g. in the middle of a rotation */
+        }
+        if (info.st_dev == info_.st_dev && info.st_ino == info_.st_ino) {
+            return false;
+        }
+        auto file = std::unique_ptr<std::FILE, File_Closer>(std::fopen(path_.c_str(), "rb"));
+        if (!file || !stat_file(file.get(), info)) {
+            return false;
+        }
+        if (!cursor.file) {
+            cursor.file = std::move(file_);
+        }
+        file_ = std::move(file);
+        info_ = info;
+        restart(0);
+        return true;
+    }
+
+  public:
+    /**
+     * @param offset Where to start reading, e.g. the `offset()` of an earlier follower of the
+     * same file. It should be the start of a line.
+     */
+    Ndjson_Follower(std::string path, const double offset)
+        : path_(std::move(path)), file_(std::fopen(path_.c_str(), "rb")) {
+        if (!file_ || !stat_file(file_.get(), info_)) {
+            Rcpp::stop("Can't open '" + path_ + "'.");
+        }
+        if (offset > static_cast<double>(info_.st_size)) {
+            Rcpp::stop("`offset` is past the end of '" + path_ + "'.");
+        }
+        if (!seek_file(file_.get(), offset)) {
+            Rcpp::stop("Can't seek in '" + path_ + "'.");
+        }
+        restart(offset);
+    }
+
+    Ndjson_Follower(const Ndjson_Follower&) = delete;
+    Ndjson_Follower& operator=(const Ndjson_Follower&) = delete;
+
+    [[nodiscard]] auto path() const noexcept -> const std::string& { return path_; }
+    [[nodiscard]] auto n_rows() const noexcept -> double { return n_rows_; }
+    [[nodiscard]] auto n_rotations() const noexcept -> double { return n_rotations_; }
+    [[nodiscard]] auto offset() const noexcept -> double { return offset_; }
+    [[nodiscard]] auto n_pending() const noexcept -> double {
+        return static_cast<double>(std::size(partial_));
+    }
+
+    /**
+     * @brief Deserialize the (at most) `chunk_rows` oldest complete documents not returned yet, or
+     * return `NULL` if none have been written since the last call.
+     *
+     * As with Ndjson_Reader::next_chunk(), the cursor only moves past the chunk once it is
+     * deserialized, and lines that failed to parse are skipped when it's read again.
+     */
+    auto next_chunk(const R_xlen_t    chunk_rows,
+                    const Parse_Opts& parse_opts,
+                    const bool        parse_error_ok) -> SEXP {
+        chunk_.clear();
+        n_skipped_  = 0;
+        auto cursor = Cursor{nullptr, info_, partial_, offset_, n_rotations_};
+        for (;;) {
+            if (is_truncated()) {
+                std::rewind(file_.get());
+                restart(0);
+                ++n_rotations_;
+            }
+            if (read_lines(chunk_rows)) {
+                break; /* full */
+            }
+            if (!reopen_if_rotated(cursor)) {
+                break; /* drained, and still the file at `path_` */
+            }
+            ++n_rotations_; /* the old file's partial line, if any, is never completed */
+        }
+
+        SEXP out = R_NilValue;
+        if (chunk_.n_docs() > 0) {
+            const auto first_row = n_rows_ + 1;
+            const auto row_of    = [this, first_row](const R_xlen_t i) {
+                return skipped_.row_of(first_row, i);
+            };
+            auto bad_rows = std::vector<double>();
+            try {
+                out = chunk_.deserialize(parser_, parse_opts, row_of, parse_error_ok, &bad_rows);
+            } catch (...) {
+                skipped_.add(bad_rows);
+                rewind_to(cursor);
+                throw;
+            }
+        }
+        n_rows_ += static_cast<double>(chunk_.n_docs()) + n_skipped_;
+        skipped_.forget_through(n_rows_);
+        return out;
+    }
+};
+
+
+/**
+ * @brief Open `path` in a new Ndjson_Follower, starting at `offset`, owned by an external pointer
+ * of class `"simdjson_ndjson_follower"`.
+ */
+inline SEXP open_ndjson_follower(const std::string& path, const double offset) {
+    auto follower          = Rcpp::XPtr<Ndjson_Follower>(new Ndjson_Follower(path, offset));
+    follower.attr("class") = "simdjson_ndjson_follower";
+    return follower;
+}
+
+
+/**
+ * @brief Open `path` in a new Ndjson_Reader owned by an external pointer of class
+ * `"simdjson_ndjson_reader"`.
+ */
+inline SEXP open_ndjson_reader(const std::string& path) {
+    auto reader          = Rcpp::XPtr<Ndjson_Reader>(new Ndjson_Reader(path));
+    reader.attr("class") = "simdjson_ndjson_reader";
+    return reader;
+}
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
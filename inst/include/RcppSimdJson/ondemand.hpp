@@ -0,0 +1,132 @@
+#ifndef RCPPSIMDJSON__ONDEMAND_HPP
+#define RCPPSIMDJSON__ONDEMAND_HPP
+
+
+#include "decompress.hpp"
+#include "mapped_file.hpp"
+#include "zero_copy.hpp"
+
+#include <string>      /* std::string */
+#include <string_view> /* std::string_view */
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief Whether a failed JSON Pointer lookup means the pointer doesn't match the document (a query
+ * error), rather than the document being invalid (a parse error).
+ */
+inline constexpr bool is_query_error(const simdjson::error_code error) noexcept {
+    switch (error) {
+        case simdjson::NO_SUCH_FIELD:
+        case simdjson::INDEX_OUT_OF_BOUNDS:
+        case simdjson::INVALID_JSON_POINTER:
+        case simdjson::INCORRECT_TYPE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+/**
+ * @brief A single JSON document (string, raw vector, or file) iterated with simdjson's On-Demand
+ * API, so JSON Pointers can be followed without building a tape for the whole document.
+ *
+ * Only structural indexing runs over the entire document. Following a pointer skips over every
+ * value that isn't on its path, and `find()` returns the target's raw JSON, which is then parsed
+ * (in place) into a DOM of its own. Parts of the document that are skipped are never validated.
+ *
+ * The JSON is kept in a padded buffer for the Ondemand_Doc's lifetime: it's either the input
+ * itself (when it can be parsed in place), a copy, a memory mapping, or the decompressed file.
+ */
+class Ondemand_Doc {
+    simdjson::padded_string      copy_;
+    utils::Padded_Buffer         decompressed_;
+    utils::Mapped_File           mapped_;
+    std::string_view             json_;
+    simdjson::ondemand::document doc_;
+
+    auto iterate(simdjson::ondemand::parser& parser, const std::string_view json)
+        -> simdjson::error_code {
+        json_ = json;
+        return parser.iterate(json.data(), json.size(), json.size() + simdjson::SIMDJSON_PADDING)
+            .get(doc_);
+    }
+
+    auto iterate_buffer(simdjson::ondemand::parser& parser, const utils::Json_Buffer& buffer)
+        -> simdjson::error_code {
+        if (!buffer.realloc_if_needed) {
+            return iterate(parser, buffer.json);
+        }
+        copy_ = simdjson::padded_string(buffer.json);
+        return iterate(parser, copy_);
+    }
+
+  public:
+    Ondemand_Doc() = default;
+    Ondemand_Doc(const Ondemand_Doc&) = delete;
+    Ondemand_Doc& operator=(const Ondemand_Doc&) = delete;
+
+    /** @brief The entire (padded) document. */
+    [[nodiscard]] auto json() const noexcept -> std::string_view { return json_; }
+
+    /**
+     * @brief Read `json` (as `parse()` would) and start iterating it with `parser`, which must
+     * outlive the Ondemand_Doc.
+     */
+    template <typename json_T, bool is_file>
+    auto load(simdjson::ondemand::parser& parser, const json_T& json, const bool use_mmap)
+        -> simdjson::error_code {
+        if constexpr (utils::resembles_vec_raw<json_T>()) {
+            return iterate_buffer(parser, utils::json_buffer(static_cast<SEXP>(json)));
+        }
+
+        if constexpr (utils::resembles_vec_chr<json_T>()) {
+            return load<decltype(json[0]), is_file>(parser, json[0], use_mmap);
+        }
+
+        if constexpr (utils::resembles_r_string<json_T>()) {
+            if constexpr (is_file) {
+                const auto file_path = std::string(json);
+                if (const auto file_type = utils::get_memDecompress_type(file_path)) {
+                    decompressed_ = utils::decompress_padded(file_path, *file_type);
+                    return iterate(parser, decompressed_.view());
+                }
+                if (use_mmap && utils::has_mmap()) {
+                    if (const auto error = mapped_.map(file_path); error) {
+                        return error;
+                    }
+                    return iterate(parser, std::string_view(mapped_.data(), mapped_.size()));
+                }
+                if (const auto error = simdjson::padded_string::load(file_path).get(copy_); error) {
+                    return error;
+                }
+                return iterate(parser, copy_);
+            } else {
+                return iterate_buffer(parser, utils::json_buffer(std::string_view(json)));
+            }
+        }
+    }
+
+    /**
+     * @brief The raw JSON of the value `json_pointer` points to. Rewinds the document first, so
+     * any number of pointers can be followed, in any order.
+     */
+    auto find(const std::string_view json_pointer) -> simdjson::simdjson_result<std::string_view> {
+        simdjson::ondemand::value value;
+        if (const auto error = doc_.at_pointer(json_pointer).get(value); error) {
+            return error;
+        }
+        return value.raw_json();
+    }
+};
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef RCPPSIMDJSON__PREFETCH_HPP
+#define RCPPSIMDJSON__PREFETCH_HPP
+
+
+#include "decompress.hpp"
+
+#include <atomic>             /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <memory>             /* std::shared_ptr */
+#include <mutex>              /* std::mutex, std::unique_lock */
+#include <string>             /* std::string */
+#include <thread>             /* std::thread */
+#include <vector>             /* std::vector */
+
+#include <sys/stat.h> /* stat */
+
+
+namespace rcppsimdjson {
+namespace utils {
+
+
+/**
+ * @brief Reads files on a background thread, ahead of the (main) thread parsing them.
+ *
+ * Files are read in order into padded buffers, at most `MAX_AHEAD` ahead of the last one taken, so
+ * reading the next files overlaps with parsing and deserializing the current one while only a few
+ * of them are held in memory at a time. Files are only read ahead while those held stay within
+ * `MAX_BYTES_AHEAD` (judging the next one by its size on disk, which underestimates compressed
+ * files): larger ones wait until they are taken, as they would without prefetching. Compressed
+ * files are decompressed by the reader when the library is available; the rest are left for
+ * `take()`'s caller, since `memDecompress()` is an R function.
+ *
+ * The reader thread is only joined by the destructor, which an R error's longjmp would skip: use
+ * a File_Prefetcher from code that can't longjmp, or under `Rcpp::unwindProtect()`.
+ */
+class File_Prefetcher {
+  public:
+    static constexpr std::size_t MAX_AHEAD       = 2;
+    static constexpr std::size_t MAX_BYTES_AHEAD = 64 << 20;
+    static constexpr std::size_t MIN_BYTES       = 1 << 20; /* see `is_worthwhile()` */
+
+    struct File {
+        simdjson::error_code    error            = simdjson::SUCCESS;
+        const char*             decompress_error = nullptr; /* from `decompress_native()` */
+        bool                    is_read          = false;   /* `false` if left to the caller */
+        simdjson::padded_string contents;                   /* uncompressed files */
+        Padded_Buffer           decompressed;               /* natively decompressed files */
+
+        /** @brief The (padded) JSON that was read. */
+        [[nodiscard]] auto json() const noexcept -> std::string_view {
+            return decompressed.data() != nullptr ? decompressed.view()
+                                                  : std::string_view(contents);
+        }
+    };
+
+  private:
+    /* shared with the reader, so it is never left with dangling state (e.g. after a longjmp) */
+    struct State {
+        std::vector<std::string> paths;
+        std::vector<bool>        skip; /* NA, or compressed without native support */
+        std::vector<File>        files;
+        std::vector<std::size_t> sizes; /* of the files read, to count them off once taken */
+        std::mutex               mutex;
+        std::condition_variable  ready;
+        std::size_t              n_read        = 0;
+        std::size_t              n_taken       = 0;
+        std::size_t              n_wanted      = 0; /* `take()` is waiting for files before that */
+        std::size_t              n_bytes_ahead = 0; /* held by files read but not taken */
+        bool                     stop          = false;
+    };
+
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+    std::thread            reader_;
+
+    static auto size_on_disk(const std::string& path) noexcept -> std::size_t {
+#ifdef _WIN32
+        struct _stat64 info;
+        const auto     ok = _stat64(path.c_str(), &info) == 0;
+#else
+        struct stat info;
+        const auto  ok = stat(path.c_str(), &info) == 0;
+#endif
+        return ok ? static_cast<std::size_t>(info.st_size) : 0;
+    }
+
+    static void read_all(const std::shared_ptr<State> state) {
+        struct Counted {
+            Counted() noexcept { ++n_readers(); }
+            ~Counted() { --n_readers(); }
+        } counted;
+
+        for (std::size_t i = 0; i < std::size(state->paths); ++i) {
+            const auto size = state->skip[i] ? 0 : size_on_disk(state->paths[i]);
+            {
+                auto lock = std::unique_lock<std::mutex>(state->mutex);
+                state->ready.wait(lock, [&] {
+                    return state->stop || i < state->n_wanted ||
+                           (i < state->n_taken + MAX_AHEAD &&
+                            state->n_bytes_ahead + size <= MAX_BYTES_AHEAD);
+                });
+                if (state->stop) {
+                    return;
+                }
+            }
+
+            /* only this thread touches `files[i]` until `n_read` is past it */
+            auto& file = state->files[i];
+            if (!state->skip[i]) {
+                const auto& path = state->paths[i];
+                if (const auto file_type = get_memDecompress_type(path)) {
+                    file.decompress_error = decompress_native(path, *file_type, file.decompressed);
+                    file.error = file.decompress_error ? simdjson::IO_ERROR : simdjson::SUCCESS;
+                } else {
+                    file.error = simdjson::padded_string::load(path).get(file.contents);
+                }
+                file.is_read = true;
+            }
+
+            {
+                auto lock       = std::unique_lock<std::mutex>(state->mutex);
+                state->sizes[i] = std::size(file.json());
+                state->n_bytes_ahead += state->sizes[i];
+                state->n_read = i + 1;
+            }
+            state->ready.notify_all();
+        }
+    }
+
+  public:
+    /** @brief The number of reader threads running, across File_Prefetchers. */
+    static auto n_readers() noexcept -> std::atomic<int>& {
+        static auto n = std::atomic<int>(0);
+        return n;
+    }
+
+    /**
+     * @brief Whether `paths` are worth a reader thread: several files, of `MIN_BYTES` or more in
+     * all. Below that, starting the thread costs about as much as it saves.
+     */
+    static auto is_worthwhile(const Rcpp::CharacterVector& paths) -> bool {
+        if (std::size(paths) < 2) {
+            return false;
+        }
+        auto n_bytes = std::size_t(0);
+        for (R_xlen_t i = 0; i < std::size(paths) && n_bytes < MIN_BYTES; ++i) {
+            if (!is_na_string(paths[i])) {
+                n_bytes += size_on_disk(std::string(paths[i]));
+            }
+        }
+        return n_bytes >= MIN_BYTES;
+    }
+
+    explicit File_Prefetcher(const Rcpp::CharacterVector& paths) {
+        const auto n = std::size(paths);
+        state_->paths.reserve(n);
+        state_->skip.reserve(n);
+        for (R_xlen_t i = 0; i < n; ++i) {
+            const auto is_na = is_na_string(paths[i]);
+            state_->paths.emplace_back(is_na ? "" : std::string(paths[i]));
+
+            const auto file_type = get_memDecompress_type(state_->paths.back());
+            state_->skip.push_back(is_na || (file_type && !has_native_decompress(*file_type)));
+        }
+        state_->files.resize(n);
+        state_->sizes.resize(n);
+
+        reader_ = std::thread(read_all, state_);
+    }
+
+    ~File_Prefetcher() {
+        {
+            auto lock    = std::unique_lock<std::mutex>(state_->mutex);
+            state_->stop = true;
+        }
+        state_->ready.notify_all();
+        reader_.join();
+    }
+
+    File_Prefetcher(const File_Prefetcher&) = delete;
+    File_Prefetcher& operator=(const File_Prefetcher&) = delete;
+
+    /**
+     * @brief Wait for file `i` to be read, then hand it over. Files must be taken in order.
+     */
+    [[nodiscard]] auto take(const std::size_t i) -> File {
+        auto lock        = std::unique_lock<std::mutex>(state_->mutex);
+        state_->n_wanted = i + 1;
+        state_->ready.notify_all();
+        state_->ready.wait(lock, [&] { return state_->n_read > i; });
+        state_->n_taken = i + 1;
+        state_->n_bytes_ahead -= state_->sizes[i];
+        lock.unlock();
+        state_->ready.notify_all();
+
+        return std::move(state_->files[i]);
+    }
+};
+
+
+} // namespace utils
+} // namespace rcppsimdjson
+
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef RCPPSIMDJSON__RESULT_CACHE_HPP
+#define RCPPSIMDJSON__RESULT_CACHE_HPP
+
+
+#include "common.hpp"
+
+#include <array>         /* std::array */
+#include <cstdint>       /* std::uint64_t */
+#include <cstring>       /* std::memcpy */
+#include <iterator>      /* std::prev */
+#include <list>          /* std::list */
+#include <optional>      /* std::optional */
+#include <string>        /* std::string */
+#include <string_view>   /* std::string_view */
+#include <unordered_map> /* std::unordered_map */
+#include <unordered_set> /* std::unordered_set */
+
+
+namespace rcppsimdjson {
+namespace deserialize {
+
+
+/**
+ * @brief Roughly the memory used by `x`, counted as `utils::object.size()` does (each distinct
+ * string once), but without materializing ALTREP vectors such as Lazy_Strings' ones.
+ */
+inline auto object_bytes(SEXP x, std::unordered_set<SEXP>& strings) -> double {
+    constexpr auto HEADER = 48.0; /* a vector's header, and each string's */
+
+    auto       bytes = HEADER;
+    const auto n     = static_cast<double>(Rf_xlength(x));
+
+    switch (TYPEOF(x)) {
+        case LGLSXP:
+        case INTSXP:
+            bytes += 4 * n;
+            break;
+        case REALSXP:
+            bytes += 8 * n;
+            break;
+        case CPLXSXP:
+            bytes += 16 * n;
+            break;
+        case RAWSXP:
+            bytes += n;
+            break;
+        case STRSXP:
+            bytes += 8 * n;
+            if (!ALTREP(x)) { /* whose strings are only made when accessed */
+                for (R_xlen_t i = 0, len = Rf_xlength(x); i < len; ++i) {
+                    const auto str = STRING_ELT(x, i);
+                    if (str != NA_STRING && strings.insert(str).second) {
+                        bytes += HEADER + LENGTH(str) + 1;
+                    }
+                }
+            }
+            break;
+        case VECSXP:
+            bytes += 8 * n;
+            for (R_xlen_t i = 0, len = Rf_xlength(x); i < len; ++i) {
+                bytes += object_bytes(VECTOR_ELT(x, i), strings);
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (const auto names = Rf_getAttrib(x, R_NamesSymbol); !Rf_isNull(names)) {
+        bytes += object_bytes(names, strings);
+    }
+    return bytes;
+}
+
+inline auto object_bytes(SEXP x) -> double {
+    auto strings = std::unordered_set<SEXP>();
+    return object_bytes(x, strings);
+}
+
+
+/**
+ * @brief A 128-bit digest of a sequence of typed byte strings, after MurmurHash3's x64 128-bit
+ * variant: distinct sequences practically never share one, yet each byte is only read once.
+ */
+class Digest {
+    std::uint64_t h1_    = 0x9E3779B97F4A7C15;
+    std::uint64_t h2_    = 0xC2B2AE3D27D4EB4F;
+    std::uint64_t bytes_ = 0;
+
+    static constexpr std::uint64_t C1 = 0x87C37B91114253D5;
+    static constexpr std::uint64_t C2 = 0x4CF5AD432745937F;
+
+    static constexpr auto rotl(const std::uint64_t x, const int r) noexcept -> std::uint64_t {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static constexpr auto fmix(std::uint64_t k) noexcept -> std::uint64_t {
+        k ^= k >> 33;
+        k *= 0xFF51AFD7ED558CCD;
+        k ^= k >> 33;
+        k *= 0xC4CEB9FE1A85EC53;
+        k ^= k >> 33;
+        return k;
+    }
+
+    void mix(std::uint64_t k1, std::uint64_t k2) noexcept {
+        h1_ ^= rotl(k1 * C1, 31) * C2;
+        h1_ = (rotl(h1_, 27) + h2_) * 5 + 0x52DCE729;
+        h2_ ^= rotl(k2 * C2, 33) * C1;
+        h2_ = (rotl(h2_, 31) + h1_) * 5 + 0x38495AB5;
+    }
+
+  public:
+    /* `size` bytes at `data`, preceded by their `type` and `size` so that no two sequences of
+     * strings hash the same bytes */
+    void add(const int type, const char* data, const std::size_t size) noexcept {
+        mix(static_cast<std::uint64_t>(type), static_cast<std::uint64_t>(size));
+
+        auto i = std::size_t(0);
+        for (; i + 16 <= size; i += 16) {
+            std::uint64_t block[2];
+            std::memcpy(block, data + i, 16);
+            mix(block[0], block[1]);
+        }
+        if (i < size) {
+            std::uint64_t tail[2] = {0, 0};
+            std::memcpy(tail, data + i, size - i);
+            mix(tail[0], tail[1]);
+        }
+        bytes_ += size;
+    }
+
+    /* the digest, followed by the number of bytes added */
+    [[nodiscard]] auto words() const noexcept -> std::array<std::uint64_t, 3> {
+        auto h1 = h1_ ^ bytes_;
+        auto h2 = h2_ ^ bytes_;
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix(h1);
+        h2 = fmix(h2);
+        h1 += h2;
+        h2 += h1;
+        return {h1, h2, bytes_};
+    }
+};
+
+
+/**
+ * @brief The key of `json`'s result in the Result_Cache: the serialized options (`opts`) it's
+ * deserialized with, followed by the Digest of its inputs' types, lengths and contents and their
+ * total length.
+ *
+ * Keys are therefore a few dozen bytes however large the inputs: they aren't compared whole on
+ * lookup, but two different inputs would need to collide on 128 well-mixed bits and their total
+ * length.
+ *
+ * File paths' identity (their size and modification time) is part of `opts`, with `json` then
+ * being `NULL`.
+ */
+inline auto result_cache_key(SEXP json, const Rcpp::RawVector& opts) -> std::string {
+    auto digest = Digest();
+
+    switch (TYPEOF(json)) {
+        case STRSXP:
+            for (R_xlen_t i = 0, n = Rf_xlength(json); i < n; ++i) {
+                if (const auto str = STRING_ELT(json, i); str == NA_STRING) {
+                    digest.add(NILSXP, nullptr, 0);
+                } else {
+                    digest.add(STRSXP, CHAR(str), static_cast<std::size_t>(LENGTH(str)));
+                }
+            }
+            break;
+        case RAWSXP:
+            digest.add(RAWSXP,
+                       reinterpret_cast<const char*>(RAW(json)),
+                       static_cast<std::size_t>(Rf_xlength(json)));
+            break;
+        case VECSXP:
+            for (R_xlen_t i = 0, n = Rf_xlength(json); i < n; ++i) {
+                const auto raw = VECTOR_ELT(json, i);
+                digest.add(VECSXP,
+                           reinterpret_cast<const char*>(RAW(raw)),
+                           static_cast<std::size_t>(Rf_xlength(raw)));
+            }
+            break;
+        default:
+            break;
+    }
+
+    const auto words = digest.words();
+    auto       key   = std::string(reinterpret_cast<const char*>(RAW(opts)), std::size(opts));
+    key.append(reinterpret_cast<const char*>(std::data(words)), sizeof(words));
+    return key;
+}
+
+
+/**
+ * @brief Mark `x` as not mutable, and with it everything it holds: its names and levels and, for
+ * lists, their elements, which R's (shallow) copies of `x` would otherwise share as modifiable.
+ */
+inline void mark_not_mutable(SEXP x) {
+    MARK_NOT_MUTABLE(x);
+    for (const auto symbol : {R_NamesSymbol, R_LevelsSymbol}) {
+        if (const auto attr = Rf_getAttrib(x, symbol); !Rf_isNull(attr)) {
+            MARK_NOT_MUTABLE(attr);
+        }
+    }
+    if (TYPEOF(x) == VECSXP) {
+        for (R_xlen_t i = 0, n = Rf_xlength(x); i < n; ++i) {
+            mark_not_mutable(VECTOR_ELT(x, i));
+        }
+    }
+}
+
+
+/**
+ * @brief The R objects most recently returned by `fparse()` and `fload()` (with `cache = TRUE`),
+ * by the key of their input and options (see `result_cache_key()`), within a memory budget.
+ *
+ * Entries are kept in least-recently-used order: whenever a new one makes the cache exceed its
+ * budget, the least recently used ones are evicted. Cached objects are marked as not mutable, all
+ * the way down (see `mark_not_mutable()`), so that R copies them before any modification.
+ */
+class Result_Cache {
+    struct Entry {
+        std::string   key;
+        Rcpp::RObject value;
+        double        bytes;
+    };
+
+    std::list<Entry> entries_; /* most recently used first */
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index_; /* of entries' keys */
+
+    double budget_    = DEFAULT_BUDGET;
+    double bytes_     = 0;
+    double hits_      = 0;
+    double misses_    = 0;
+    double evictions_ = 0;
+
+    void drop(const std::list<Entry>::iterator entry) {
+        bytes_ -= entry->bytes;
+        index_.erase(entry->key);
+        entries_.erase(entry);
+    }
+
+    void evict_to(const double budget) {
+        while (bytes_ > budget && !entries_.empty()) {
+            drop(std::prev(std::end(entries_)));
+            ++evictions_;
+        }
+    }
+
+    Result_Cache() = default;
+
+  public:
+    static constexpr double DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+    Result_Cache(const Result_Cache&) = delete;
+    Result_Cache& operator=(const Result_Cache&) = delete;
+
+    /* never destroyed, since R may be gone by the time static objects are */
+    [[nodiscard]] static auto instance() -> Result_Cache& {
+        static auto* const cache = new Result_Cache();
+        return *cache;
+    }
+
+    [[nodiscard]] auto get(const std::string& key) -> std::optional<SEXP> {
+        const auto found = index_.find(key);
+        if (found == std::end(index_)) {
+            ++misses_;
+            return std::nullopt;
+        }
+        ++hits_;
+        entries_.splice(std::begin(entries_), entries_, found->second);
+        return found->second->value;
+    }
+
+    /**
+     * @brief Cache `value` as `key`'s, unless it alone exceeds the budget.
+     */
+    void put(std::string key, SEXP value) {
+        if (const auto found = index_.find(key); found != std::end(index_)) {
+            drop(found->second);
+        }
+        const auto bytes = object_bytes(value) + static_cast<double>(std::size(key));
+        if (bytes > budget_) {
+            return;
+        }
+
+        mark_not_mutable(value);
+        entries_.push_front(Entry{std::move(key), Rcpp::RObject(value), bytes});
+        index_.emplace(entries_.front().key, std::begin(entries_));
+        bytes_ += bytes;
+        evict_to(budget_);
+    }
+
+    void set_budget(const double budget) {
+        budget_ = budget;
+        evict_to(budget_);
+    }
+
+    /* drop every entry and reset the counters */
+    void clear() {
+        index_.clear();
+        entries_.clear();
+        bytes_ = hits_ = misses_ = evictions_ = 0;
+    }
+
+    [[nodiscard]] auto info() const -> Rcpp::List {
+        return Rcpp::List::create(Rcpp::_["hits"]      = hits_,
+                                  Rcpp::_["misses"]    = misses_,
+                                  Rcpp::_["evictions"] = evictions_,
+                                  Rcpp::_["entries"]   = static_cast<double>(std::size(entries_)),
+                                  Rcpp::_["bytes"]     = bytes_,
+                                  Rcpp::_["budget"]    = budget_);
+    }
+};
+
+
+} // namespace deserialize
+} // namespace rcppsimdjson
+
+
+#endif
@@ -47,7 +47,9 @@ inline SEXP as_integer64(int64_t x) {
 inline SEXP as_integer64(const std::vector<int64_t>& x) {
     const auto          n = std::size(x);
     Rcpp::NumericVector out(n);
-    std::memcpy(&(out[0]), &(x[0]), n * sizeof(double));
+    if (n > 0) {
+        std::memcpy(&(out[0]), &(x[0]), n * sizeof(double));
+    }
     out.attr("class") = "integer64";
     return out;
 }
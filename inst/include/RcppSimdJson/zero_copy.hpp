@@ -0,0 +1,111 @@
+#ifndef RCPPSIMDJSON__ZERO_COPY_HPP
+#define RCPPSIMDJSON__ZERO_COPY_HPP
+
+
+#include "common.hpp"
+
+#include <cstdint>     /* std::uintptr_t */
+#include <string_view> /* std::string_view */
+
+
+/* reading past the end of an allocation is (deliberately) what the fast path does, so it's off
+ * whenever a tool that would flag it is compiled in; define RCPPSIMDJSON_NO_ZERO_COPY to force it
+ * off, e.g. when running under valgrind */
+#if defined(__SANITIZE_ADDRESS__)
+#    define RCPPSIMDJSON_NO_ZERO_COPY 1
+#elif defined(__has_feature)
+#    if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#        define RCPPSIMDJSON_NO_ZERO_COPY 1
+#    endif
+#endif
+
+
+namespace rcppsimdjson {
+namespace utils {
+
+
+/**
+ * @brief The smallest page size of any supported platform. Pages are never smaller, and larger
+ * pages are multiples of it, so a run of bytes that doesn't cross a multiple of it never crosses a
+ * page boundary either.
+ */
+inline static constexpr std::uintptr_t MIN_PAGE_SIZE = 4096;
+
+
+/**
+ * @brief Whether the simdjson::SIMDJSON_PADDING bytes following `json` can safely be read.
+ *
+ * Memory protection works on whole pages, so when the padding lies in the same page as the last
+ * byte of `json`, it is readable (if meaningless) memory. simdjson never lets those bytes affect
+ * the result: stage 1 copies the final partial block into a buffer of its own, and stage 2 only
+ * over-reads within values that the structural indexes have already delimited.
+ */
+inline auto is_padding_readable(const std::string_view json) noexcept -> bool {
+#ifdef RCPPSIMDJSON_NO_ZERO_COPY
+    return static_cast<void>(json), false;
+#else
+    if (json.empty()) {
+        return false;
+    }
+    const auto last = reinterpret_cast<std::uintptr_t>(json.data()) + json.size() - 1;
+    return last / MIN_PAGE_SIZE == (last + simdjson::SIMDJSON_PADDING) / MIN_PAGE_SIZE;
+#endif
+}
+
+
+/**
+ * @brief Name of the attribute marking a `raw` vector created by `as_padded_raw()`, holding the
+ * number of padding bytes that end it.
+ */
+inline static constexpr auto PADDING_ATTR = "simdjson_padding";
+
+
+/**
+ * @brief A JSON buffer, and whether simdjson must copy it into a padded buffer of its own before
+ * parsing (its `realloc_if_needed` argument).
+ */
+struct Json_Buffer {
+    std::string_view json;
+    bool             realloc_if_needed = true;
+};
+
+
+/**
+ * @brief The JSON held by a `raw` vector, which is parsed in place if it was created by
+ * `as_padded_raw()` or happens to have readable padding.
+ *
+ * The attribute is trusted only if it still covers at least simdjson::SIMDJSON_PADDING bytes
+ * within the vector.
+ */
+inline auto json_buffer(SEXP raw) -> Json_Buffer {
+    const auto data = reinterpret_cast<const char*>(RAW(raw));
+    const auto size = static_cast<std::size_t>(Rf_xlength(raw));
+
+    if (const SEXP padding = Rf_getAttrib(raw, Rf_install(PADDING_ATTR));
+        TYPEOF(padding) == INTSXP && Rf_xlength(padding) == 1) {
+        if (const auto n = INTEGER(padding)[0];
+            n != NA_INTEGER && static_cast<std::size_t>(n) >= simdjson::SIMDJSON_PADDING &&
+            static_cast<std::size_t>(n) <= size) {
+            return {std::string_view(data, size - static_cast<std::size_t>(n)), false};
+        }
+    }
+
+    const auto json = std::string_view(data, size);
+    return {json, !is_padding_readable(json)};
+}
+
+
+/**
+ * @brief The JSON held by a string, which is parsed in place if it happens to have readable
+ * padding.
+ */
+inline auto json_buffer(const std::string_view json) noexcept -> Json_Buffer {
+    return {json, !is_padding_readable(json)};
+}
+
+
+} // namespace utils
+} // namespace rcppsimdjson
+
+
+#endif
@@ -24,17 +24,17 @@ namespace RcppSimdJson {
         }
     }
 
-    inline SEXP _deserialize_json(SEXP json, SEXP query = R_NilValue, SEXP empty_array = R_NilValue, SEXP empty_object = R_NilValue, SEXP single_null = R_NilValue, const bool parse_error_ok = false, SEXP on_parse_error = R_NilValue, const bool query_error_ok = false, SEXP on_query_error = R_NilValue, const int simplify_to = 0, const int type_policy = 0, const int int64_r_type = 0) {
-        typedef SEXP(*Ptr__deserialize_json)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+    inline SEXP _deserialize_json(SEXP json, SEXP query = R_NilValue, SEXP empty_array = R_NilValue, SEXP empty_object = R_NilValue, SEXP single_null = R_NilValue, const bool parse_error_ok = false, SEXP on_parse_error = R_NilValue, const bool query_error_ok = false, SEXP on_query_error = R_NilValue, const int simplify_to = 0, const int type_policy = 0, const int int64_r_type = 0, const int threads = 1, SEXP parser = R_NilValue, SEXP schema = R_NilValue, SEXP select = R_NilValue, const int engine = 0, const bool lazy_strings = false, const int max_factor_levels = 0, const int output = 0) {
+        typedef SEXP(*Ptr__deserialize_json)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
         static Ptr__deserialize_json p__deserialize_json = NULL;
         if (p__deserialize_json == NULL) {
-            validateSignature("SEXP(*_deserialize_json)(SEXP,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int)");
+            validateSignature("SEXP(*_deserialize_json)(SEXP,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int,const int,SEXP,SEXP,SEXP,const int,const bool,const int,const int)");
             p__deserialize_json = (Ptr__deserialize_json)R_GetCCallable("RcppSimdJson", "_RcppSimdJson__deserialize_json");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p__deserialize_json(Shield<SEXP>(Rcpp::wrap(json)), Shield<SEXP>(Rcpp::wrap(query)), Shield<SEXP>(Rcpp::wrap(empty_array)), Shield<SEXP>(Rcpp::wrap(empty_object)), Shield<SEXP>(Rcpp::wrap(single_null)), Shield<SEXP>(Rcpp::wrap(parse_error_ok)), Shield<SEXP>(Rcpp::wrap(on_parse_error)), Shield<SEXP>(Rcpp::wrap(query_error_ok)), Shield<SEXP>(Rcpp::wrap(on_query_error)), Shield<SEXP>(Rcpp::wrap(simplify_to)), Shield<SEXP>(Rcpp::wrap(type_policy)), Shield<SEXP>(Rcpp::wrap(int64_r_type)));
+            rcpp_result_gen = p__deserialize_json(Shield<SEXP>(Rcpp::wrap(json)), Shield<SEXP>(Rcpp::wrap(query)), Shield<SEXP>(Rcpp::wrap(empty_array)), Shield<SEXP>(Rcpp::wrap(empty_object)), Shield<SEXP>(Rcpp::wrap(single_null)), Shield<SEXP>(Rcpp::wrap(parse_error_ok)), Shield<SEXP>(Rcpp::wrap(on_parse_error)), Shield<SEXP>(Rcpp::wrap(query_error_ok)), Shield<SEXP>(Rcpp::wrap(on_query_error)), Shield<SEXP>(Rcpp::wrap(simplify_to)), Shield<SEXP>(Rcpp::wrap(type_policy)), Shield<SEXP>(Rcpp::wrap(int64_r_type)), Shield<SEXP>(Rcpp::wrap(threads)), Shield<SEXP>(Rcpp::wrap(parser)), Shield<SEXP>(Rcpp::wrap(schema)), Shield<SEXP>(Rcpp::wrap(select)), Shield<SEXP>(Rcpp::wrap(engine)), Shield<SEXP>(Rcpp::wrap(lazy_strings)), Shield<SEXP>(Rcpp::wrap(max_factor_levels)), Shield<SEXP>(Rcpp::wrap(output)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
@@ -45,17 +45,17 @@ namespace RcppSimdJson {
         return Rcpp::as<SEXP >(rcpp_result_gen);
     }
 
-    inline SEXP _load_json(const Rcpp::CharacterVector& json, SEXP query = R_NilValue, SEXP empty_array = R_NilValue, SEXP empty_object = R_NilValue, SEXP single_null = R_NilValue, const bool parse_error_ok = false, SEXP on_parse_error = R_NilValue, const bool query_error_ok = false, SEXP on_query_error = R_NilValue, const int simplify_to = 0, const int type_policy = 0, const int int64_r_type = 0) {
-        typedef SEXP(*Ptr__load_json)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
+    inline SEXP _load_json(const Rcpp::CharacterVector& json, SEXP query = R_NilValue, SEXP empty_array = R_NilValue, SEXP empty_object = R_NilValue, SEXP single_null = R_NilValue, const bool parse_error_ok = false, SEXP on_parse_error = R_NilValue, const bool query_error_ok = false, SEXP on_query_error = R_NilValue, const int simplify_to = 0, const int type_policy = 0, const int int64_r_type = 0, const int threads = 1, SEXP parser = R_NilValue, const bool use_mmap = false, SEXP schema = R_NilValue, SEXP select = R_NilValue, const int engine = 0, const bool lazy_strings = false, const int max_factor_levels = 0, const int output = 0, SEXP tape_cache = R_NilValue) {
+        typedef SEXP(*Ptr__load_json)(SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP,SEXP);
         static Ptr__load_json p__load_json = NULL;
         if (p__load_json == NULL) {
-            validateSignature("SEXP(*_load_json)(const Rcpp::CharacterVector&,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int)");
+            validateSignature("SEXP(*_load_json)(const Rcpp::CharacterVector&,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int,const int,SEXP,const bool,SEXP,SEXP,const int,const bool,const int,const int,SEXP)");
             p__load_json = (Ptr__load_json)R_GetCCallable("RcppSimdJson", "_RcppSimdJson__load_json");
         }
         RObject rcpp_result_gen;
         {
             RNGScope RCPP_rngScope_gen;
-            rcpp_result_gen = p__load_json(Shield<SEXP>(Rcpp::wrap(json)), Shield<SEXP>(Rcpp::wrap(query)), Shield<SEXP>(Rcpp::wrap(empty_array)), Shield<SEXP>(Rcpp::wrap(empty_object)), Shield<SEXP>(Rcpp::wrap(single_null)), Shield<SEXP>(Rcpp::wrap(parse_error_ok)), Shield<SEXP>(Rcpp::wrap(on_parse_error)), Shield<SEXP>(Rcpp::wrap(query_error_ok)), Shield<SEXP>(Rcpp::wrap(on_query_error)), Shield<SEXP>(Rcpp::wrap(simplify_to)), Shield<SEXP>(Rcpp::wrap(type_policy)), Shield<SEXP>(Rcpp::wrap(int64_r_type)));
+            rcpp_result_gen = p__load_json(Shield<SEXP>(Rcpp::wrap(json)), Shield<SEXP>(Rcpp::wrap(query)), Shield<SEXP>(Rcpp::wrap(empty_array)), Shield<SEXP>(Rcpp::wrap(empty_object)), Shield<SEXP>(Rcpp::wrap(single_null)), Shield<SEXP>(Rcpp::wrap(parse_error_ok)), Shield<SEXP>(Rcpp::wrap(on_parse_error)), Shield<SEXP>(Rcpp::wrap(query_error_ok)), Shield<SEXP>(Rcpp::wrap(on_query_error)), Shield<SEXP>(Rcpp::wrap(simplify_to)), Shield<SEXP>(Rcpp::wrap(type_policy)), Shield<SEXP>(Rcpp::wrap(int64_r_type)), Shield<SEXP>(Rcpp::wrap(threads)), Shield<SEXP>(Rcpp::wrap(parser)), Shield<SEXP>(Rcpp::wrap(use_mmap)), Shield<SEXP>(Rcpp::wrap(schema)), Shield<SEXP>(Rcpp::wrap(select)), Shield<SEXP>(Rcpp::wrap(engine)), Shield<SEXP>(Rcpp::wrap(lazy_strings)), Shield<SEXP>(Rcpp::wrap(max_factor_levels)), Shield<SEXP>(Rcpp::wrap(output)), Shield<SEXP>(Rcpp::wrap(tape_cache)));
         }
         if (rcpp_result_gen.inherits("interrupted-error"))
             throw Rcpp::internal::InterruptedException();
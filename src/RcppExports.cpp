@@ -13,9 +13,24 @@ Rcpp::Rostream<true>&  Rcpp::Rcout = Rcpp::Rcpp_cout_get();
 Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
+// benchmark_phases
+Rcpp::NumericVector benchmark_phases(const std::string& file, const int simplify_to, const int type_policy, const int int64_r_type, const int times);
+RcppExport SEXP _RcppSimdJson_benchmark_phases(SEXP fileSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP timesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
+    Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
+    Rcpp::traits::input_parameter< const int >::type times(timesSEXP);
+    rcpp_result_gen = Rcpp::wrap(benchmark_phases(file, simplify_to, type_policy, int64_r_type, times));
+    return rcpp_result_gen;
+END_RCPP
+}
 // deserialize
-SEXP deserialize(SEXP json, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool parse_error_ok, SEXP on_parse_error, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type);
-static SEXP _RcppSimdJson_deserialize_try(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP) {
+SEXP deserialize(SEXP json, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool parse_error_ok, SEXP on_parse_error, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type, const int threads, SEXP parser, SEXP schema, SEXP select, const int engine, const bool lazy_strings, const int max_factor_levels, const int output);
+static SEXP _RcppSimdJson_deserialize_try(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP threadsSEXP, SEXP parserSEXP, SEXP schemaSEXP, SEXP selectSEXP, SEXP engineSEXP, SEXP lazy_stringsSEXP, SEXP max_factor_levelsSEXP, SEXP outputSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::traits::input_parameter< SEXP >::type json(jsonSEXP);
@@ -30,15 +45,23 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
     Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
     Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
-    rcpp_result_gen = Rcpp::wrap(deserialize(json, query, empty_array, empty_object, single_null, parse_error_ok, on_parse_error, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type));
+    Rcpp::traits::input_parameter< const int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type parser(parserSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type schema(schemaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type select(selectSEXP);
+    Rcpp::traits::input_parameter< const int >::type engine(engineSEXP);
+    Rcpp::traits::input_parameter< const bool >::type lazy_strings(lazy_stringsSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_factor_levels(max_factor_levelsSEXP);
+    Rcpp::traits::input_parameter< const int >::type output(outputSEXP);
+    rcpp_result_gen = Rcpp::wrap(deserialize(json, query, empty_array, empty_object, single_null, parse_error_ok, on_parse_error, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type, threads, parser, schema, select, engine, lazy_strings, max_factor_levels, output));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _RcppSimdJson_deserialize(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP) {
+RcppExport SEXP _RcppSimdJson_deserialize(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP threadsSEXP, SEXP parserSEXP, SEXP schemaSEXP, SEXP selectSEXP, SEXP engineSEXP, SEXP lazy_stringsSEXP, SEXP max_factor_levelsSEXP, SEXP outputSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_RcppSimdJson_deserialize_try(jsonSEXP, querySEXP, empty_arraySEXP, empty_objectSEXP, single_nullSEXP, parse_error_okSEXP, on_parse_errorSEXP, query_error_okSEXP, on_query_errorSEXP, simplify_toSEXP, type_policySEXP, int64_r_typeSEXP));
+        rcpp_result_gen = PROTECT(_RcppSimdJson_deserialize_try(jsonSEXP, querySEXP, empty_arraySEXP, empty_objectSEXP, single_nullSEXP, parse_error_okSEXP, on_parse_errorSEXP, query_error_okSEXP, on_query_errorSEXP, simplify_toSEXP, type_policySEXP, int64_r_typeSEXP, threadsSEXP, parserSEXP, schemaSEXP, selectSEXP, engineSEXP, lazy_stringsSEXP, max_factor_levelsSEXP, outputSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -59,8 +82,8 @@ RcppExport SEXP _RcppSimdJson_deserialize(SEXP jsonSEXP, SEXP querySEXP, SEXP em
     return rcpp_result_gen;
 }
 // load
-SEXP load(const Rcpp::CharacterVector& json, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool parse_error_ok, SEXP on_parse_error, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type);
-static SEXP _RcppSimdJson_load_try(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP) {
+SEXP load(const Rcpp::CharacterVector& json, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool parse_error_ok, SEXP on_parse_error, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type, const int threads, SEXP parser, const bool use_mmap, SEXP schema, SEXP select, const int engine, const bool lazy_strings, const int max_factor_levels, const int output, SEXP tape_cache);
+static SEXP _RcppSimdJson_load_try(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP threadsSEXP, SEXP parserSEXP, SEXP use_mmapSEXP, SEXP schemaSEXP, SEXP selectSEXP, SEXP engineSEXP, SEXP lazy_stringsSEXP, SEXP max_factor_levelsSEXP, SEXP outputSEXP, SEXP tape_cacheSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type json(jsonSEXP);
@@ -75,15 +98,25 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
     Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
     Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
-    rcpp_result_gen = Rcpp::wrap(load(json, query, empty_array, empty_object, single_null, parse_error_ok, on_parse_error, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type));
+    Rcpp::traits::input_parameter< const int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type parser(parserSEXP);
+    Rcpp::traits::input_parameter< const bool >::type use_mmap(use_mmapSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type schema(schemaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type select(selectSEXP);
+    Rcpp::traits::input_parameter< const int >::type engine(engineSEXP);
+    Rcpp::traits::input_parameter< const bool >::type lazy_strings(lazy_stringsSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_factor_levels(max_factor_levelsSEXP);
+    Rcpp::traits::input_parameter< const int >::type output(outputSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tape_cache(tape_cacheSEXP);
+    rcpp_result_gen = Rcpp::wrap(load(json, query, empty_array, empty_object, single_null, parse_error_ok, on_parse_error, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type, threads, parser, use_mmap, schema, select, engine, lazy_strings, max_factor_levels, output, tape_cache));
     return rcpp_result_gen;
 END_RCPP_RETURN_ERROR
 }
-RcppExport SEXP _RcppSimdJson_load(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP) {
+RcppExport SEXP _RcppSimdJson_load(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP threadsSEXP, SEXP parserSEXP, SEXP use_mmapSEXP, SEXP schemaSEXP, SEXP selectSEXP, SEXP engineSEXP, SEXP lazy_stringsSEXP, SEXP max_factor_levelsSEXP, SEXP outputSEXP, SEXP tape_cacheSEXP) {
     SEXP rcpp_result_gen;
     {
         Rcpp::RNGScope rcpp_rngScope_gen;
-        rcpp_result_gen = PROTECT(_RcppSimdJson_load_try(jsonSEXP, querySEXP, empty_arraySEXP, empty_objectSEXP, single_nullSEXP, parse_error_okSEXP, on_parse_errorSEXP, query_error_okSEXP, on_query_errorSEXP, simplify_toSEXP, type_policySEXP, int64_r_typeSEXP));
+        rcpp_result_gen = PROTECT(_RcppSimdJson_load_try(jsonSEXP, querySEXP, empty_arraySEXP, empty_objectSEXP, single_nullSEXP, parse_error_okSEXP, on_parse_errorSEXP, query_error_okSEXP, on_query_errorSEXP, simplify_toSEXP, type_policySEXP, int64_r_typeSEXP, threadsSEXP, parserSEXP, use_mmapSEXP, schemaSEXP, selectSEXP, engineSEXP, lazy_stringsSEXP, max_factor_levelsSEXP, outputSEXP, tape_cacheSEXP));
     }
     Rboolean rcpp_isInterrupt_gen = Rf_inherits(rcpp_result_gen, "interrupted-error");
     if (rcpp_isInterrupt_gen) {
@@ -169,6 +202,48 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// parse_handle
+SEXP parse_handle(SEXP json);
+RcppExport SEXP _RcppSimdJson_parse_handle(SEXP jsonSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type json(jsonSEXP);
+    rcpp_result_gen = Rcpp::wrap(parse_handle(json));
+    return rcpp_result_gen;
+END_RCPP
+}
+// query_handle
+SEXP query_handle(SEXP handle, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type);
+RcppExport SEXP _RcppSimdJson_query_handle(SEXP handleSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type query(querySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_array(empty_arraySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_object(empty_objectSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type single_null(single_nullSEXP);
+    Rcpp::traits::input_parameter< const bool >::type query_error_ok(query_error_okSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type on_query_error(on_query_errorSEXP);
+    Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
+    Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
+    rcpp_result_gen = Rcpp::wrap(query_handle(handle, query, empty_array, empty_object, single_null, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type));
+    return rcpp_result_gen;
+END_RCPP
+}
+// handle_type
+std::string handle_type(SEXP handle);
+RcppExport SEXP _RcppSimdJson_handle_type(SEXP handleSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type handle(handleSEXP);
+    rcpp_result_gen = Rcpp::wrap(handle_type(handle));
+    return rcpp_result_gen;
+END_RCPP
+}
 // is_valid_json_arg
 bool is_valid_json_arg(SEXP json);
 RcppExport SEXP _RcppSimdJson_is_valid_json_arg(SEXP jsonSEXP) {
@@ -202,6 +277,207 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// prefetch_threads
+int prefetch_threads();
+RcppExport SEXP _RcppSimdJson_prefetch_threads() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(prefetch_threads());
+    return rcpp_result_gen;
+END_RCPP
+}
+// deserialize_ndjson
+SEXP deserialize_ndjson(SEXP json, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool parse_error_ok, SEXP on_parse_error, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type);
+RcppExport SEXP _RcppSimdJson_deserialize_ndjson(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type json(jsonSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type query(querySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_array(empty_arraySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_object(empty_objectSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type single_null(single_nullSEXP);
+    Rcpp::traits::input_parameter< const bool >::type parse_error_ok(parse_error_okSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type on_parse_error(on_parse_errorSEXP);
+    Rcpp::traits::input_parameter< const bool >::type query_error_ok(query_error_okSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type on_query_error(on_query_errorSEXP);
+    Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
+    Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
+    rcpp_result_gen = Rcpp::wrap(deserialize_ndjson(json, query, empty_array, empty_object, single_null, parse_error_ok, on_parse_error, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type));
+    return rcpp_result_gen;
+END_RCPP
+}
+// load_ndjson
+SEXP load_ndjson(const Rcpp::CharacterVector& json, SEXP query, SEXP empty_array, SEXP empty_object, SEXP single_null, const bool parse_error_ok, SEXP on_parse_error, const bool query_error_ok, SEXP on_query_error, const int simplify_to, const int type_policy, const int int64_r_type, const bool use_mmap);
+RcppExport SEXP _RcppSimdJson_load_ndjson(SEXP jsonSEXP, SEXP querySEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP parse_error_okSEXP, SEXP on_parse_errorSEXP, SEXP query_error_okSEXP, SEXP on_query_errorSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP use_mmapSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type json(jsonSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type query(querySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_array(empty_arraySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_object(empty_objectSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type single_null(single_nullSEXP);
+    Rcpp::traits::input_parameter< const bool >::type parse_error_ok(parse_error_okSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type on_parse_error(on_parse_errorSEXP);
+    Rcpp::traits::input_parameter< const bool >::type query_error_ok(query_error_okSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type on_query_error(on_query_errorSEXP);
+    Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
+    Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
+    Rcpp::traits::input_parameter< const bool >::type use_mmap(use_mmapSEXP);
+    rcpp_result_gen = Rcpp::wrap(load_ndjson(json, query, empty_array, empty_object, single_null, parse_error_ok, on_parse_error, query_error_ok, on_query_error, simplify_to, type_policy, int64_r_type, use_mmap));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ndjson_reader
+SEXP ndjson_reader(const std::string& path);
+RcppExport SEXP _RcppSimdJson_ndjson_reader(SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    rcpp_result_gen = Rcpp::wrap(ndjson_reader(path));
+    return rcpp_result_gen;
+END_RCPP
+}
+// next_chunk
+SEXP next_chunk(SEXP reader, const int chunk_rows, SEXP empty_array, SEXP empty_object, SEXP single_null, const int simplify_to, const int type_policy, const int int64_r_type, SEXP schema, SEXP select, const int max_factor_levels, const bool parse_error_ok);
+RcppExport SEXP _RcppSimdJson_next_chunk(SEXP readerSEXP, SEXP chunk_rowsSEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP schemaSEXP, SEXP selectSEXP, SEXP max_factor_levelsSEXP, SEXP parse_error_okSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type reader(readerSEXP);
+    Rcpp::traits::input_parameter< const int >::type chunk_rows(chunk_rowsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_array(empty_arraySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_object(empty_objectSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type single_null(single_nullSEXP);
+    Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
+    Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type schema(schemaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type select(selectSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_factor_levels(max_factor_levelsSEXP);
+    Rcpp::traits::input_parameter< const bool >::type parse_error_ok(parse_error_okSEXP);
+    rcpp_result_gen = Rcpp::wrap(next_chunk(reader, chunk_rows, empty_array, empty_object, single_null, simplify_to, type_policy, int64_r_type, schema, select, max_factor_levels, parse_error_ok));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ndjson_reader_info
+Rcpp::List ndjson_reader_info(SEXP reader);
+RcppExport SEXP _RcppSimdJson_ndjson_reader_info(SEXP readerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type reader(readerSEXP);
+    rcpp_result_gen = Rcpp::wrap(ndjson_reader_info(reader));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ndjson_follower
+SEXP ndjson_follower(const std::string& path, const double offset);
+RcppExport SEXP _RcppSimdJson_ndjson_follower(SEXP pathSEXP, SEXP offsetSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const double >::type offset(offsetSEXP);
+    rcpp_result_gen = Rcpp::wrap(ndjson_follower(path, offset));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ndjson_follower_info
+Rcpp::List ndjson_follower_info(SEXP follower);
+RcppExport SEXP _RcppSimdJson_ndjson_follower_info(SEXP followerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type follower(followerSEXP);
+    rcpp_result_gen = Rcpp::wrap(ndjson_follower_info(follower));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ndjson_index
+Rcpp::NumericVector ndjson_index(const std::string& path);
+RcppExport SEXP _RcppSimdJson_ndjson_index(SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    rcpp_result_gen = Rcpp::wrap(ndjson_index(path));
+    return rcpp_result_gen;
+END_RCPP
+}
+// load_rows
+SEXP load_rows(const std::string& path, const Rcpp::NumericVector& offsets, const double size, const Rcpp::NumericVector& rows, SEXP empty_array, SEXP empty_object, SEXP single_null, const int simplify_to, const int type_policy, const int int64_r_type, SEXP schema, SEXP select, const int max_factor_levels);
+RcppExport SEXP _RcppSimdJson_load_rows(SEXP pathSEXP, SEXP offsetsSEXP, SEXP sizeSEXP, SEXP rowsSEXP, SEXP empty_arraySEXP, SEXP empty_objectSEXP, SEXP single_nullSEXP, SEXP simplify_toSEXP, SEXP type_policySEXP, SEXP int64_r_typeSEXP, SEXP schemaSEXP, SEXP selectSEXP, SEXP max_factor_levelsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type offsets(offsetsSEXP);
+    Rcpp::traits::input_parameter< const double >::type size(sizeSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type rows(rowsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_array(empty_arraySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type empty_object(empty_objectSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type single_null(single_nullSEXP);
+    Rcpp::traits::input_parameter< const int >::type simplify_to(simplify_toSEXP);
+    Rcpp::traits::input_parameter< const int >::type type_policy(type_policySEXP);
+    Rcpp::traits::input_parameter< const int >::type int64_r_type(int64_r_typeSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type schema(schemaSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type select(selectSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_factor_levels(max_factor_levelsSEXP);
+    rcpp_result_gen = Rcpp::wrap(load_rows(path, offsets, size, rows, empty_array, empty_object, single_null, simplify_to, type_policy, int64_r_type, schema, select, max_factor_levels));
+    return rcpp_result_gen;
+END_RCPP
+}
+// as_padded_raw
+Rcpp::RawVector as_padded_raw(SEXP json);
+RcppExport SEXP _RcppSimdJson_as_padded_raw(SEXP jsonSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type json(jsonSEXP);
+    rcpp_result_gen = Rcpp::wrap(as_padded_raw(json));
+    return rcpp_result_gen;
+END_RCPP
+}
+// decompress_body
+Rcpp::RawVector decompress_body(const Rcpp::RawVector& body);
+RcppExport SEXP _RcppSimdJson_decompress_body(SEXP bodySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::RawVector& >::type body(bodySEXP);
+    rcpp_result_gen = Rcpp::wrap(decompress_body(body));
+    return rcpp_result_gen;
+END_RCPP
+}
+// simdjson_parser
+SEXP simdjson_parser(const double capacity, const int max_depth);
+RcppExport SEXP _RcppSimdJson_simdjson_parser(SEXP capacitySEXP, SEXP max_depthSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const double >::type capacity(capacitySEXP);
+    Rcpp::traits::input_parameter< const int >::type max_depth(max_depthSEXP);
+    rcpp_result_gen = Rcpp::wrap(simdjson_parser(capacity, max_depth));
+    return rcpp_result_gen;
+END_RCPP
+}
+// simdjson_parser_info
+Rcpp::List simdjson_parser_info(SEXP parser);
+RcppExport SEXP _RcppSimdJson_simdjson_parser_info(SEXP parserSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type parser(parserSEXP);
+    rcpp_result_gen = Rcpp::wrap(simdjson_parser_info(parser));
+    return rcpp_result_gen;
+END_RCPP
+}
 // check_int64
 SEXP check_int64();
 RcppExport SEXP _RcppSimdJson_check_int64() {
@@ -212,6 +488,70 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// result_cache_key
+Rcpp::RawVector result_cache_key(SEXP json, const Rcpp::RawVector& opts);
+RcppExport SEXP _RcppSimdJson_result_cache_key(SEXP jsonSEXP, SEXP optsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type json(jsonSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::RawVector& >::type opts(optsSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_cache_key(json, opts));
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_cache_get
+SEXP result_cache_get(const Rcpp::RawVector& key);
+RcppExport SEXP _RcppSimdJson_result_cache_get(SEXP keySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::RawVector& >::type key(keySEXP);
+    rcpp_result_gen = Rcpp::wrap(result_cache_get(key));
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_cache_put
+SEXP result_cache_put(const Rcpp::RawVector& key, SEXP value);
+RcppExport SEXP _RcppSimdJson_result_cache_put(SEXP keySEXP, SEXP valueSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::RawVector& >::type key(keySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type value(valueSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_cache_put(key, value));
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_cache_info
+Rcpp::List result_cache_info();
+RcppExport SEXP _RcppSimdJson_result_cache_info() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(result_cache_info());
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_cache_budget
+void result_cache_budget(const double budget);
+RcppExport SEXP _RcppSimdJson_result_cache_budget(SEXP budgetSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const double >::type budget(budgetSEXP);
+    result_cache_budget(budget);
+    return R_NilValue;
+END_RCPP
+}
+// result_cache_clear
+void result_cache_clear();
+RcppExport SEXP _RcppSimdJson_result_cache_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    result_cache_clear();
+    return R_NilValue;
+END_RCPP
+}
 // validateJSON
 bool validateJSON(const std::string filename);
 RcppExport SEXP _RcppSimdJson_validateJSON(SEXP filenameSEXP) {
@@ -257,8 +597,8 @@ END_RCPP
 static int _RcppSimdJson_RcppExport_validate(const char* sig) { 
     static std::set<std::string> signatures;
     if (signatures.empty()) {
-        signatures.insert("SEXP(*.deserialize_json)(SEXP,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int)");
-        signatures.insert("SEXP(*.load_json)(const Rcpp::CharacterVector&,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int)");
+        signatures.insert("SEXP(*.deserialize_json)(SEXP,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int,const int,SEXP,SEXP,SEXP,const int,const bool,const int,const int)");
+        signatures.insert("SEXP(*.load_json)(const Rcpp::CharacterVector&,SEXP,SEXP,SEXP,SEXP,const bool,SEXP,const bool,SEXP,const int,const int,const int,const int,SEXP,const bool,SEXP,SEXP,const int,const bool,const int,const int,SEXP)");
         signatures.insert("bool(*.exceptions_enabled)()");
     }
     return signatures.find(sig) != signatures.end();
@@ -274,16 +614,40 @@ RcppExport SEXP _RcppSimdJson_RcppExport_registerCCallable() {
 }
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_RcppSimdJson_deserialize", (DL_FUNC) &_RcppSimdJson_deserialize, 12},
-    {"_RcppSimdJson_load", (DL_FUNC) &_RcppSimdJson_load, 12},
+    {"_RcppSimdJson_benchmark_phases", (DL_FUNC) &_RcppSimdJson_benchmark_phases, 5},
+    {"_RcppSimdJson_deserialize", (DL_FUNC) &_RcppSimdJson_deserialize, 20},
+    {"_RcppSimdJson_load", (DL_FUNC) &_RcppSimdJson_load, 22},
     {"_RcppSimdJson_exceptions_enabled", (DL_FUNC) &_RcppSimdJson_exceptions_enabled, 0},
     {"_RcppSimdJson_dispatch_is_valid_json", (DL_FUNC) &_RcppSimdJson_dispatch_is_valid_json, 1},
     {"_RcppSimdJson_dispatch_is_valid_utf8", (DL_FUNC) &_RcppSimdJson_dispatch_is_valid_utf8, 1},
     {"_RcppSimdJson_dispatch_fminify", (DL_FUNC) &_RcppSimdJson_dispatch_fminify, 1},
+    {"_RcppSimdJson_parse_handle", (DL_FUNC) &_RcppSimdJson_parse_handle, 1},
+    {"_RcppSimdJson_query_handle", (DL_FUNC) &_RcppSimdJson_query_handle, 10},
+    {"_RcppSimdJson_handle_type", (DL_FUNC) &_RcppSimdJson_handle_type, 1},
     {"_RcppSimdJson_is_valid_json_arg", (DL_FUNC) &_RcppSimdJson_is_valid_json_arg, 1},
     {"_RcppSimdJson_is_valid_query_arg", (DL_FUNC) &_RcppSimdJson_is_valid_query_arg, 1},
     {"_RcppSimdJson_diagnose_input", (DL_FUNC) &_RcppSimdJson_diagnose_input, 1},
+    {"_RcppSimdJson_prefetch_threads", (DL_FUNC) &_RcppSimdJson_prefetch_threads, 0},
+    {"_RcppSimdJson_deserialize_ndjson", (DL_FUNC) &_RcppSimdJson_deserialize_ndjson, 12},
+    {"_RcppSimdJson_load_ndjson", (DL_FUNC) &_RcppSimdJson_load_ndjson, 13},
+    {"_RcppSimdJson_ndjson_reader", (DL_FUNC) &_RcppSimdJson_ndjson_reader, 1},
+    {"_RcppSimdJson_next_chunk", (DL_FUNC) &_RcppSimdJson_next_chunk, 12},
+    {"_RcppSimdJson_ndjson_reader_info", (DL_FUNC) &_RcppSimdJson_ndjson_reader_info, 1},
+    {"_RcppSimdJson_ndjson_follower", (DL_FUNC) &_RcppSimdJson_ndjson_follower, 2},
+    {"_RcppSimdJson_ndjson_follower_info", (DL_FUNC) &_RcppSimdJson_ndjson_follower_info, 1},
+    {"_RcppSimdJson_ndjson_index", (DL_FUNC) &_RcppSimdJson_ndjson_index, 1},
+    {"_RcppSimdJson_load_rows", (DL_FUNC) &_RcppSimdJson_load_rows, 13},
+    {"_RcppSimdJson_as_padded_raw", (DL_FUNC) &_RcppSimdJson_as_padded_raw, 1},
+    {"_RcppSimdJson_decompress_body", (DL_FUNC) &_RcppSimdJson_decompress_body, 1},
+    {"_RcppSimdJson_simdjson_parser", (DL_FUNC) &_RcppSimdJson_simdjson_parser, 2},
+    {"_RcppSimdJson_simdjson_parser_info", (DL_FUNC) &_RcppSimdJson_simdjson_parser_info, 1},
     {"_RcppSimdJson_check_int64", (DL_FUNC) &_RcppSimdJson_check_int64, 0},
+    {"_RcppSimdJson_result_cache_key", (DL_FUNC) &_RcppSimdJson_result_cache_key, 2},
+    {"_RcppSimdJson_result_cache_get", (DL_FUNC) &_RcppSimdJson_result_cache_get, 1},
+    {"_RcppSimdJson_result_cache_put", (DL_FUNC) &_RcppSimdJson_result_cache_put, 2},
+    {"_RcppSimdJson_result_cache_info", (DL_FUNC) &_RcppSimdJson_result_cache_info, 0},
+    {"_RcppSimdJson_result_cache_budget", (DL_FUNC) &_RcppSimdJson_result_cache_budget, 1},
+    {"_RcppSimdJson_result_cache_clear", (DL_FUNC) &_RcppSimdJson_result_cache_clear, 0},
     {"_RcppSimdJson_validateJSON", (DL_FUNC) &_RcppSimdJson_validateJSON, 1},
     {"_RcppSimdJson_parseExample", (DL_FUNC) &_RcppSimdJson_parseExample, 0},
     {"_RcppSimdJson_cppVersion", (DL_FUNC) &_RcppSimdJson_cppVersion, 0},
@@ -292,7 +656,9 @@ static const R_CallMethodDef CallEntries[] = {
     {NULL, NULL, 0}
 };
 
+void init_lazy_strings(DllInfo* dll);
 RcppExport void R_init_RcppSimdJson(DllInfo *dll) {
     R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
     R_useDynamicSymbols(dll, FALSE);
+    init_lazy_strings(dll);
 }
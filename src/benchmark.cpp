@@ -0,0 +1,35 @@
+#if __cplusplus >= 201703L
+#    include <RcppSimdJson.hpp>
+#    include <RcppSimdJson/benchmark.hpp>
+#endif
+
+
+// [[Rcpp::export(.benchmark_phases)]]
+Rcpp::NumericVector benchmark_phases(const std::string& file,
+                                     const int          simplify_to  = 0,
+                                     const int          type_policy  = 0,
+                                     const int          int64_r_type = 0,
+                                     const int          times        = 10) {
+    using namespace rcppsimdjson;
+
+    simdjson::padded_string json;
+    if (auto error = simdjson::padded_string::load(file).get(json); error != simdjson::SUCCESS) {
+        Rcpp::stop(simdjson::error_message(error));
+    }
+
+    const auto parse_opts = deserialize::Parse_Opts{
+        static_cast<deserialize::Simplify_To>(simplify_to),
+        static_cast<deserialize::Type_Policy>(type_policy),
+        static_cast<utils::Int64_R_Type>(int64_r_type),
+        R_NilValue,
+        R_NilValue,
+        R_NilValue};
+
+    simdjson::dom::parser parser;
+    const auto            timings = benchmark::time_phases(parser, json, parse_opts, times);
+
+    return Rcpp::NumericVector::create(Rcpp::_["bytes"]       = static_cast<double>(json.size()),
+                                       Rcpp::_["parse"]       = timings.parse,
+                                       Rcpp::_["diagnose"]    = timings.diagnose,
+                                       Rcpp::_["deserialize"] = timings.deserialize);
+}
@@ -6,17 +6,25 @@
 
 // [[Rcpp::export(.deserialize_json)]]
 SEXP deserialize(SEXP       json,
-                 SEXP       query          = R_NilValue,
-                 SEXP       empty_array    = R_NilValue,
-                 SEXP       empty_object   = R_NilValue,
-                 SEXP       single_null    = R_NilValue,
-                 const bool parse_error_ok = false,
-                 SEXP       on_parse_error = R_NilValue,
-                 const bool query_error_ok = false,
-                 SEXP       on_query_error = R_NilValue,
-                 const int  simplify_to    = 0,
-                 const int  type_policy    = 0,
-                 const int  int64_r_type   = 0) {
+                 SEXP       query             = R_NilValue,
+                 SEXP       empty_array       = R_NilValue,
+                 SEXP       empty_object      = R_NilValue,
+                 SEXP       single_null       = R_NilValue,
+                 const bool parse_error_ok    = false,
+                 SEXP       on_parse_error    = R_NilValue,
+                 const bool query_error_ok    = false,
+                 SEXP       on_query_error    = R_NilValue,
+                 const int  simplify_to       = 0,
+                 const int  type_policy       = 0,
+                 const int  int64_r_type      = 0,
+                 const int  threads           = 1,
+                 SEXP       parser            = R_NilValue,
+                 SEXP       schema            = R_NilValue,
+                 SEXP       select            = R_NilValue,
+                 const int  engine            = 0,
+                 const bool lazy_strings      = false,
+                 const int  max_factor_levels = 0,
+                 const int  output            = 0) {
     using namespace rcppsimdjson;
 
     if (utils::is_single_json_arg(json)) {
@@ -34,7 +42,16 @@ SEXP deserialize(SEXP       json,
                                                                    on_query_error,
                                                                    simplify_to,
                                                                    type_policy,
-                                                                   int64_r_type)
+                                                                   int64_r_type,
+                                                                   threads,
+                                                                   parser,
+                                                                   false,
+                                                                   schema,
+                                                                   select,
+                                                                   engine,
+                                                                   lazy_strings,
+                                                                   max_factor_levels,
+                                                                   output)
                    : deserialize::start<deserialize::IS_NOT_FILE,
                                         deserialize::SINGLE_JSON,
                                         deserialize::NOT_SINGLE_QUERY>(json,
@@ -48,7 +65,16 @@ SEXP deserialize(SEXP       json,
                                                                        on_query_error,
                                                                        simplify_to,
                                                                        type_policy,
-                                                                       int64_r_type);
+                                                                       int64_r_type,
+                                                                       threads,
+                                                                       parser,
+                                                                       false,
+                                                                       schema,
+                                                                       select,
+                                                                       engine,
+                                                                       lazy_strings,
+                                                                       max_factor_levels,
+                                                                       output);
     } else { /* !is_single_json */
         return utils::is_single_query_arg(query)
                    ? deserialize::start<deserialize::IS_NOT_FILE,
@@ -64,7 +90,16 @@ SEXP deserialize(SEXP       json,
                                                                    on_query_error,
                                                                    simplify_to,
                                                                    type_policy,
-                                                                   int64_r_type)
+                                                                   int64_r_type,
+                                                                   threads,
+                                                                   parser,
+                                                                   false,
+                                                                   schema,
+                                                                   select,
+                                                                   engine,
+                                                                   lazy_strings,
+                                                                   max_factor_levels,
+                                                                   output)
                    : deserialize::start<deserialize::IS_NOT_FILE,
                                         deserialize::NOT_SINGLE_JSON,
                                         deserialize::NOT_SINGLE_QUERY>(json,
@@ -78,24 +113,43 @@ SEXP deserialize(SEXP       json,
                                                                        on_query_error,
                                                                        simplify_to,
                                                                        type_policy,
-                                                                       int64_r_type);
+                                                                       int64_r_type,
+                                                                       threads,
+                                                                       parser,
+                                                                       false,
+                                                                       schema,
+                                                                       select,
+                                                                       engine,
+                                                                       lazy_strings,
+                                                                       max_factor_levels,
+                                                                       output);
     }
 }
 
 
 // [[Rcpp::export(.load_json)]]
 SEXP load(const Rcpp::CharacterVector& json,
-          SEXP                         query          = R_NilValue,
-          SEXP                         empty_array    = R_NilValue,
-          SEXP                         empty_object   = R_NilValue,
-          SEXP                         single_null    = R_NilValue,
-          const bool                   parse_error_ok = false,
-          SEXP                         on_parse_error = R_NilValue,
-          const bool                   query_error_ok = false,
-          SEXP                         on_query_error = R_NilValue,
-          const int                    simplify_to    = 0,
-          const int                    type_policy    = 0,
-          const int                    int64_r_type   = 0) {
+          SEXP                         query             = R_NilValue,
+          SEXP                         empty_array       = R_NilValue,
+          SEXP                         empty_object      = R_NilValue,
+          SEXP                         single_null       = R_NilValue,
+          const bool                   parse_error_ok    = false,
+          SEXP                         on_parse_error    = R_NilValue,
+          const bool                   query_error_ok    = false,
+          SEXP                         on_query_error    = R_NilValue,
+          const int                    simplify_to       = 0,
+          const int                    type_policy       = 0,
+          const int                    int64_r_type      = 0,
+          const int                    threads           = 1,
+          SEXP                         parser            = R_NilValue,
+          const bool                   use_mmap          = false,
+          SEXP                         schema            = R_NilValue,
+          SEXP                         select            = R_NilValue,
+          const int                    engine            = 0,
+          const bool                   lazy_strings      = false,
+          const int                    max_factor_levels = 0,
+          const int                    output            = 0,
+          SEXP                         tape_cache        = R_NilValue) {
     using namespace rcppsimdjson;
 
     if (utils::is_single_json_arg(json)) {
@@ -113,7 +167,17 @@ SEXP load(const Rcpp::CharacterVector& json,
                                                                    on_query_error,
                                                                    simplify_to,
                                                                    type_policy,
-                                                                   int64_r_type)
+                                                                   int64_r_type,
+                                                                   threads,
+                                                                   parser,
+                                                                   use_mmap,
+                                                                   schema,
+                                                                   select,
+                                                                   engine,
+                                                                   lazy_strings,
+                                                                   max_factor_levels,
+                                                                   output,
+                                                                   tape_cache)
                    : deserialize::start<deserialize::IS_FILE,
                                         deserialize::SINGLE_JSON,
                                         deserialize::NOT_SINGLE_QUERY>(json,
@@ -127,7 +191,17 @@ SEXP load(const Rcpp::CharacterVector& json,
                                                                        on_query_error,
                                                                        simplify_to,
                                                                        type_policy,
-                                                                       int64_r_type);
+                                                                       int64_r_type,
+                                                                       threads,
+                                                                       parser,
+                                                                       use_mmap,
+                                                                       schema,
+                                                                       select,
+                                                                       engine,
+                                                                       lazy_strings,
+                                                                       max_factor_levels,
+                                                                       output,
+                                                                       tape_cache);
     } else { /* !is_single_json */
         return utils::is_single_query_arg(query)
                    ? deserialize::start<deserialize::IS_FILE,
@@ -143,7 +217,17 @@ SEXP load(const Rcpp::CharacterVector& json,
                                                                    on_query_error,
                                                                    simplify_to,
                                                                    type_policy,
-                                                                   int64_r_type)
+                                                                   int64_r_type,
+                                                                   threads,
+                                                                   parser,
+                                                                   use_mmap,
+                                                                   schema,
+                                                                   select,
+                                                                   engine,
+                                                                   lazy_strings,
+                                                                   max_factor_levels,
+                                                                   output,
+                                                                   tape_cache)
                    : deserialize::start<deserialize::IS_FILE,
                                         deserialize::NOT_SINGLE_JSON,
                                         deserialize::NOT_SINGLE_QUERY>(json,
@@ -157,11 +241,29 @@ SEXP load(const Rcpp::CharacterVector& json,
                                                                        on_query_error,
                                                                        simplify_to,
                                                                        type_policy,
-                                                                       int64_r_type);
+                                                                       int64_r_type,
+                                                                       threads,
+                                                                       parser,
+                                                                       use_mmap,
+                                                                       schema,
+                                                                       select,
+                                                                       engine,
+                                                                       lazy_strings,
+                                                                       max_factor_levels,
+                                                                       output,
+                                                                       tape_cache);
     }
 }
 
 
+// [[Rcpp::init]]
+void init_lazy_strings(DllInfo* dll) {
+#if __cplusplus >= 201703L
+    rcppsimdjson::deserialize::lazy_strings::init(dll);
+#endif
+}
+
+
 // # nocov start
 // [[Rcpp::export(.exceptions_enabled)]]
 bool exceptions_enabled() {
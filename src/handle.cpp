@@ -0,0 +1,59 @@
+#if __cplusplus >= 201703L
+#    include <RcppSimdJson.hpp>
+#endif
+
+
+// [[Rcpp::export(.parse_handle)]]
+SEXP parse_handle(SEXP json) {
+    return rcppsimdjson::deserialize::parse_handle(json);
+}
+
+
+// [[Rcpp::export(.query_handle)]]
+SEXP query_handle(SEXP       handle,
+                  SEXP       query          = R_NilValue,
+                  SEXP       empty_array    = R_NilValue,
+                  SEXP       empty_object   = R_NilValue,
+                  SEXP       single_null    = R_NilValue,
+                  const bool query_error_ok = false,
+                  SEXP       on_query_error = R_NilValue,
+                  const int  simplify_to    = 0,
+                  const int  type_policy    = 0,
+                  const int  int64_r_type   = 0) {
+    using namespace rcppsimdjson;
+
+    const auto parse_opts = deserialize::Parse_Opts{
+        static_cast<deserialize::Simplify_To>(simplify_to),
+        static_cast<deserialize::Type_Policy>(type_policy),
+        static_cast<utils::Int64_R_Type>(int64_r_type),
+        empty_array,
+        empty_object,
+        single_null};
+
+    return query_error_ok
+               ? deserialize::query_handle<deserialize::QUERY_ERROR_OK>(
+                     handle, query, on_query_error, parse_opts)
+               : deserialize::query_handle<deserialize::QUERY_ERROR_NOT_OK>(
+                     handle, query, on_query_error, parse_opts);
+}
+
+
+// [[Rcpp::export(.handle_type)]]
+std::string handle_type(SEXP handle) {
+    using rcppsimdjson::deserialize::Document_Handle;
+
+    switch (Rcpp::XPtr<Document_Handle>(handle).checked_get()->root.type()) {
+        case simdjson::dom::element_type::ARRAY:
+            return "array";
+        case simdjson::dom::element_type::OBJECT:
+            return "object";
+        case simdjson::dom::element_type::STRING:
+            return "string";
+        case simdjson::dom::element_type::BOOL:
+            return "boolean";
+        case simdjson::dom::element_type::NULL_VALUE:
+            return "null";
+        default:
+            return "number";
+    }
+}
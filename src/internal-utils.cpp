@@ -1,4 +1,5 @@
 #include <RcppSimdJson/utils.hpp>
+#include <RcppSimdJson/prefetch.hpp>
 
 // [[Rcpp::export(.is_valid_json_arg)]]
 bool is_valid_json_arg(SEXP json) {
@@ -87,3 +88,10 @@ SEXP diagnose_input(const Rcpp::CharacterVector& x) {
     out.attr("row.names") = Rcpp::seq_len(n);
     return out;
 }
+
+
+/* the number of File_Prefetcher reader threads running, for tests that none is left behind */
+// [[Rcpp::export(.prefetch_threads)]]
+int prefetch_threads() {
+    return rcppsimdjson::utils::File_Prefetcher::n_readers();
+}
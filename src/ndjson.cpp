@@ -0,0 +1,196 @@
+#if __cplusplus >= 201703L
+#    include <RcppSimdJson.hpp>
+#endif
+
+
+// [[Rcpp::export(.deserialize_ndjson)]]
+SEXP deserialize_ndjson(SEXP       json,
+                        SEXP       query          = R_NilValue,
+                        SEXP       empty_array    = R_NilValue,
+                        SEXP       empty_object   = R_NilValue,
+                        SEXP       single_null    = R_NilValue,
+                        const bool parse_error_ok = false,
+                        SEXP       on_parse_error = R_NilValue,
+                        const bool query_error_ok = false,
+                        SEXP       on_query_error = R_NilValue,
+                        const int  simplify_to    = 0,
+                        const int  type_policy    = 0,
+                        const int  int64_r_type   = 0) {
+    using namespace rcppsimdjson;
+
+    return deserialize::start_ndjson<deserialize::IS_NOT_FILE>(json,
+                                                               query,
+                                                               empty_array,
+                                                               empty_object,
+                                                               single_null,
+                                                               parse_error_ok,
+                                                               on_parse_error,
+                                                               query_error_ok,
+                                                               on_query_error,
+                                                               simplify_to,
+                                                               type_policy,
+                                                               int64_r_type);
+}
+
+
+// [[Rcpp::export(.load_ndjson)]]
+SEXP load_ndjson(const Rcpp::CharacterVector& json,
+                 SEXP                         query          = R_NilValue,
+                 SEXP                         empty_array    = R_NilValue,
+                 SEXP                         empty_object   = R_NilValue,
+                 SEXP                         single_null    = R_NilValue,
+                 const bool                   parse_error_ok = false,
+                 SEXP                         on_parse_error = R_NilValue,
+                 const bool                   query_error_ok = false,
+                 SEXP                         on_query_error = R_NilValue,
+                 const int                    simplify_to    = 0,
+                 const int                    type_policy    = 0,
+                 const int                    int64_r_type   = 0,
+                 const bool                   use_mmap       = false) {
+    using namespace rcppsimdjson;
+
+    return deserialize::start_ndjson<deserialize::IS_FILE>(json,
+                                                           query,
+                                                           empty_array,
+                                                           empty_object,
+                                                           single_null,
+                                                           parse_error_ok,
+                                                           on_parse_error,
+                                                           query_error_ok,
+                                                           on_query_error,
+                                                           simplify_to,
+                                                           type_policy,
+                                                           int64_r_type,
+                                                           use_mmap);
+}
+
+
+// [[Rcpp::export(.ndjson_reader)]]
+SEXP ndjson_reader(const std::string& path) {
+    return rcppsimdjson::deserialize::open_ndjson_reader(path);
+}
+
+
+// [[Rcpp::export(.next_chunk)]]
+SEXP next_chunk(SEXP       reader,
+                const int  chunk_rows,
+                SEXP       empty_array       = R_NilValue,
+                SEXP       empty_object      = R_NilValue,
+                SEXP       single_null       = R_NilValue,
+                const int  simplify_to       = 0,
+                const int  type_policy       = 0,
+                const int  int64_r_type      = 0,
+                SEXP       schema            = R_NilValue,
+                SEXP       select            = R_NilValue,
+                const int  max_factor_levels = 0,
+                const bool parse_error_ok    = false) {
+    using namespace rcppsimdjson;
+
+    auto compiled_schema = std::optional<deserialize::Schema>();
+    if (!Rf_isNull(schema)) {
+        compiled_schema.emplace(schema);
+    }
+    auto compiled_selection = std::optional<deserialize::Selection>();
+    if (!Rf_isNull(select)) {
+        compiled_selection.emplace(select);
+    }
+
+    const auto parse_opts = deserialize::Parse_Opts{
+        static_cast<deserialize::Simplify_To>(simplify_to),
+        static_cast<deserialize::Type_Policy>(type_policy),
+        static_cast<utils::Int64_R_Type>(int64_r_type),
+        empty_array,
+        empty_object,
+        single_null,
+        1,
+        false,
+        compiled_schema ? &*compiled_schema : nullptr,
+        compiled_selection ? &*compiled_selection : nullptr,
+        nullptr,
+        max_factor_levels};
+
+    if (Rf_inherits(reader, "simdjson_ndjson_follower")) {
+        return Rcpp::XPtr<deserialize::Ndjson_Follower>(reader).checked_get()->next_chunk(
+            chunk_rows, parse_opts, parse_error_ok);
+    }
+    return Rcpp::XPtr<deserialize::Ndjson_Reader>(reader).checked_get()->next_chunk(
+        chunk_rows, parse_opts, parse_error_ok);
+}
+
+
+// [[Rcpp::export(.ndjson_reader_info)]]
+Rcpp::List ndjson_reader_info(SEXP reader) {
+    const auto r = Rcpp::XPtr<rcppsimdjson::deserialize::Ndjson_Reader>(reader).checked_get();
+
+    return Rcpp::List::create(Rcpp::_["path"]    = r->path(),
+                              Rcpp::_["rows"]    = r->n_rows(),
+                              Rcpp::_["bytes"]   = r->n_bytes(),
+                              Rcpp::_["is_done"] = r->is_done());
+}
+
+
+// [[Rcpp::export(.ndjson_follower)]]
+SEXP ndjson_follower(const std::string& path, const double offset = 0) {
+    return rcppsimdjson::deserialize::open_ndjson_follower(path, offset);
+}
+
+
+// [[Rcpp::export(.ndjson_follower_info)]]
+Rcpp::List ndjson_follower_info(SEXP follower) {
+    const auto f = Rcpp::XPtr<rcppsimdjson::deserialize::Ndjson_Follower>(follower).checked_get();
+
+    return Rcpp::List::create(Rcpp::_["path"]      = f->path(),
+                              Rcpp::_["rows"]      = f->n_rows(),
+                              Rcpp::_["offset"]    = f->offset(),
+                              Rcpp::_["pending"]   = f->n_pending(),
+                              Rcpp::_["rotations"] = f->n_rotations());
+}
+
+
+// [[Rcpp::export(.ndjson_index)]]
+Rcpp::NumericVector ndjson_index(const std::string& path) {
+    return rcppsimdjson::deserialize::index_ndjson(path);
+}
+
+
+// [[Rcpp::export(.load_rows)]]
+SEXP load_rows(const std::string&         path,
+               const Rcpp::NumericVector& offsets,
+               const double               size,
+               const Rcpp::NumericVector& rows,
+               SEXP                       empty_array       = R_NilValue,
+               SEXP                       empty_object      = R_NilValue,
+               SEXP                       single_null       = R_NilValue,
+               const int                  simplify_to       = 0,
+               const int                  type_policy       = 0,
+               const int                  int64_r_type      = 0,
+               SEXP                       schema            = R_NilValue,
+               SEXP                       select            = R_NilValue,
+               const int                  max_factor_levels = 0) {
+    using namespace rcppsimdjson;
+
+    auto compiled_schema = std::optional<deserialize::Schema>();
+    if (!Rf_isNull(schema)) {
+        compiled_schema.emplace(schema);
+    }
+    auto compiled_selection = std::optional<deserialize::Selection>();
+    if (!Rf_isNull(select)) {
+        compiled_selection.emplace(select);
+    }
+
+    const auto parse_opts = deserialize::Parse_Opts{
+        static_cast<deserialize::Simplify_To>(simplify_to),
+        static_cast<deserialize::Type_Policy>(type_policy),
+        static_cast<utils::Int64_R_Type>(int64_r_type),
+        empty_array,
+        empty_object,
+        single_null,
+        1,
+        false,
+        compiled_schema ? &*compiled_schema : nullptr,
+        compiled_selection ? &*compiled_selection : nullptr,
+        nullptr,
+        max_factor_levels};
+
+    return deserialize::load_ndjson_rows(path, offsets, size, rows, parse_opts);
+}
@@ -0,0 +1,51 @@
+#if __cplusplus >= 201703L
+#    include <RcppSimdJson.hpp>
+#endif
+
+
+// [[Rcpp::export(.as_padded_raw)]]
+Rcpp::RawVector as_padded_raw(SEXP json) {
+    using namespace rcppsimdjson;
+
+    const auto input = TYPEOF(json) == RAWSXP
+                           ? std::string_view(reinterpret_cast<const char*>(RAW(json)),
+                                              static_cast<std::size_t>(Rf_xlength(json)))
+                           : std::string_view(Rcpp::CharacterVector(json)[0]);
+
+    /* zero-initialized, so the padding is already in place */
+    const auto n_bytes = std::size(input) + simdjson::SIMDJSON_PADDING;
+    auto       out     = Rcpp::RawVector(static_cast<R_xlen_t>(n_bytes));
+    std::copy(std::begin(input), std::end(input), reinterpret_cast<char*>(RAW(out)));
+
+    out.attr(utils::PADDING_ATTR) = static_cast<int>(simdjson::SIMDJSON_PADDING);
+    return out;
+}
+
+
+// [[Rcpp::export(.decompress_body)]]
+Rcpp::RawVector decompress_body(const Rcpp::RawVector& body) {
+    using namespace rcppsimdjson;
+
+    const auto bytes = std::string_view(reinterpret_cast<const char*>(RAW(body)),
+                                        static_cast<std::size_t>(std::size(body)));
+    const auto file_type = utils::get_compression_type(bytes);
+    if (!file_type) {
+        return body;
+    }
+    if (!utils::has_native_decompress(*file_type)) {
+        return Rcpp::Function("memDecompress")(body, Rcpp::String(std::string(*file_type)), false);
+    }
+
+    utils::Padded_Buffer decompressed;
+    if (const auto error = utils::decompress_native_bytes(bytes, *file_type, decompressed)) {
+        Rcpp::stop("Failed to decompress downloaded body (%s).", error);
+    }
+
+    /* zero-initialized, so the padding is already in place */
+    const auto n_bytes = decompressed.size() + simdjson::SIMDJSON_PADDING;
+    auto       out     = Rcpp::RawVector(static_cast<R_xlen_t>(n_bytes));
+    std::copy_n(decompressed.data(), decompressed.size(), reinterpret_cast<char*>(RAW(out)));
+
+    out.attr(utils::PADDING_ATTR) = static_cast<int>(simdjson::SIMDJSON_PADDING);
+    return out;
+}
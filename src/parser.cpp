@@ -0,0 +1,41 @@
+#if __cplusplus >= 201703L
+#    include <RcppSimdJson.hpp>
+#endif
+
+
+// [[Rcpp::export(.simdjson_parser)]]
+SEXP simdjson_parser(const double capacity = 0, const int max_depth = 1024) {
+    if (!std::isfinite(capacity) || capacity < 0 || max_depth == NA_INTEGER || max_depth < 1) {
+        Rcpp::stop("`capacity` must be a non-negative number, `max_depth` a positive integer.");
+    }
+
+    /* clamped while still a double, since casting an out-of-range one is undefined */
+    constexpr auto min_bytes = static_cast<double>(simdjson::dom::MINIMAL_DOCUMENT_CAPACITY);
+    constexpr auto max_bytes = static_cast<double>(simdjson::SIMDJSON_MAXSIZE_BYTES);
+    const auto     n_bytes   = static_cast<std::size_t>(std::clamp(capacity, min_bytes, max_bytes));
+
+    /* max_capacity stays at simdjson's default: larger documents just grow the buffers */
+    auto parser = Rcpp::XPtr<simdjson::dom::parser>(new simdjson::dom::parser());
+
+    /* reserve the tape and string buffers up front so the first parse doesn't have to */
+    if (auto error = parser->allocate(n_bytes, static_cast<std::size_t>(max_depth));
+        error != simdjson::SUCCESS) {
+        Rcpp::stop(simdjson::error_message(error)); // # nocov
+    }
+    if (auto error = parser->doc.allocate(n_bytes); error != simdjson::SUCCESS) {
+        Rcpp::stop(simdjson::error_message(error)); // # nocov
+    }
+
+    parser.attr("class") = "simdjson_parser";
+    return parser;
+}
+
+
+// [[Rcpp::export(.simdjson_parser_info)]]
+Rcpp::List simdjson_parser_info(SEXP parser) {
+    const auto p = Rcpp::XPtr<simdjson::dom::parser>(parser).checked_get();
+
+    return Rcpp::List::create(Rcpp::_["capacity"]     = static_cast<double>(p->capacity()),
+                              Rcpp::_["max_capacity"] = static_cast<double>(p->max_capacity()),
+                              Rcpp::_["max_depth"]    = static_cast<int>(p->max_depth()));
+}
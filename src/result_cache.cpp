@@ -0,0 +1,51 @@
+#if __cplusplus >= 201703L
+#    include <RcppSimdJson.hpp>
+#endif
+
+
+// [[Rcpp::export(.result_cache_key)]]
+Rcpp::RawVector result_cache_key(SEXP json, const Rcpp::RawVector& opts) {
+    const auto key = rcppsimdjson::deserialize::result_cache_key(json, opts);
+
+    return Rcpp::RawVector(std::begin(key), std::end(key));
+}
+
+
+/* `list(value)` if `key` is cached, so that cached `NULL`s aren't misses; otherwise `NULL` */
+// [[Rcpp::export(.result_cache_get)]]
+SEXP result_cache_get(const Rcpp::RawVector& key) {
+    using rcppsimdjson::deserialize::Result_Cache;
+
+    const auto value = Result_Cache::instance().get(std::string(std::begin(key), std::end(key)));
+    if (!value) {
+        return R_NilValue;
+    }
+    return Rcpp::List::create(*value);
+}
+
+
+// [[Rcpp::export(.result_cache_put)]]
+SEXP result_cache_put(const Rcpp::RawVector& key, SEXP value) {
+    using rcppsimdjson::deserialize::Result_Cache;
+
+    Result_Cache::instance().put(std::string(std::begin(key), std::end(key)), value);
+    return value;
+}
+
+
+// [[Rcpp::export(.result_cache_info)]]
+Rcpp::List result_cache_info() {
+    return rcppsimdjson::deserialize::Result_Cache::instance().info();
+}
+
+
+// [[Rcpp::export(.result_cache_budget)]]
+void result_cache_budget(const double budget) {
+    rcppsimdjson::deserialize::Result_Cache::instance().set_budget(budget);
+}
+
+
+// [[Rcpp::export(.result_cache_clear)]]
+void result_cache_clear() {
+    rcppsimdjson::deserialize::Result_Cache::instance().clear();
+}